@@ -1,138 +1,253 @@
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <filesystem>
 #include <functional>
 #include <iostream>
-#include <tuple>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <random>
+#include <string>
+#include <type_traits>
 
+#include <visionsycl/batch.hpp>
+#include <visionsycl/compound.hpp>
+#include <visionsycl/dispatch.hpp>
+#include <visionsycl/edges.hpp>
+#include <visionsycl/fixed_point.hpp>
+#include <visionsycl/fusion.hpp>
+#include <visionsycl/histogram.hpp>
+#include <visionsycl/host.hpp>
 #include <visionsycl/image.hpp>
+#include <visionsycl/integral.hpp>
+#include <visionsycl/io_stage.hpp>
+#include <visionsycl/memory.hpp>
+#include <visionsycl/morphology.hpp>
+#include <visionsycl/multi_device.hpp>
+#include <visionsycl/pipeline.hpp>
+#include <visionsycl/planar.hpp>
 #include <visionsycl/processing.hpp>
+#include <visionsycl/resize.hpp>
 #include <visionsycl/selector.hpp>
+#include <visionsycl/separable.hpp>
+#include <visionsycl/streaming.hpp>
+#include <visionsycl/tiled.hpp>
+#include <visionsycl/timing.hpp>
+#include <visionsycl/warmup.hpp>
 
 namespace ch = std::chrono;
 namespace fs = std::filesystem;
 namespace vn = visionsycl;
 
-int main(int argc, char** argv) {
-    constexpr const size_t default_rounds = 1000;
-    size_t rounds = default_rounds;
+using Events = std::vector<sycl::event>;
 
-    // Ensure correct number of arguments
-    if (argc < 3 || argc > 4) {
-        std::cerr << "Usage: " << argv[0] << " [INPUT IMAGE] [OUTPUT PATH] [[ROUNDS] = " << rounds << "]" << std::endl;
-        return 1;
-    }
+// One benchmark entry. func submits the work and returns the events to wait
+// on and time; bytes is the minimum global memory traffic of one call, used
+// for the effective bandwidth.
+struct Benchmark {
+    std::string title;
+    std::string prefix;
+    bool save;
+    size_t bytes;
+    std::function<Events(void)> func;
+};
 
-    // Ensure rounds is a number
-    if (argc == 4) {
-        auto arg = std::string(argv[3]);
-        try {
-            std::size_t pos;
-            rounds = std::stoi(arg, &pos);
+using BenchmarkList = std::vector<Benchmark>;
 
-            if (pos < arg.size()) {
-                std::cerr << "Error: [ROUNDS] not a number" << std::endl;
-                rounds = default_rounds;
-            }
-        } catch (std::invalid_argument const& ex) {
-            std::cerr << "Error: [ROUNDS] is an invalid argument" << std::endl;
-            rounds = default_rounds;
-        } catch (std::out_of_range const& ex) {
-            std::cerr << "Error: [ROUNDS] is out of range" << std::endl;
-            rounds = default_rounds;
-        }
-    }
+struct Settings {
+    fs::path inpath;
+    fs::path outpath;
+    std::string label;
+    size_t rounds;
+    size_t warmup;
+    size_t depth;
+    size_t budget;
+    bool save;
+    bool batch;
+    std::string startup;
+    vn::IoStage* io;
+};
 
-    // Ensure input and output are valid
-    fs::path inpath(argv[1]);
-    if (!inpath.has_filename()) {
-        std::cerr << "Error: [INPUT IMAGE] must be an image file, e.g. JPG or PNG" << std::endl;
-        return 2;
-    }
-    fs::path outpath(argv[2]);
-    if (outpath.has_filename()) {
-        std::cerr << "Error: [OUTPUT PATH] must be a path to output image file" << std::endl;
-        return 3;
-    }
+struct Record {
+    std::string label;
+    std::string memory;
+    std::string prefix;
+    std::string title;
+    int width;
+    int height;
+    int channels;
+    size_t bytes;
+    std::string startup;
+    double first;
+    vn::LatencyStats device;
+    vn::LatencyStats host;
+    double megapixels_per_second;
+    double gigabytes_per_second;
+};
 
-    // Device definitions
-    auto q = sycl::queue{ vn::priority_backend_selector_v };
-    auto is_usm_compatible = q.get_device().has(sycl::aspect::usm_device_allocations);
+void run_benchmarks(const BenchmarkList& functions, const std::function<void(std::string)>& save_func, const std::string& memory, const vn::Image& input, const Settings& settings, std::vector<Record>& records) {
+    auto elapsed = [](ch::high_resolution_clock::time_point start) {
+        return ch::duration<double, std::milli>(ch::high_resolution_clock::now() - start).count();
+    };
 
-    // Display device information
-    std::cout << "Device: " << q.get_device().get_info<sycl::info::device::name>() << std::endl
-              << "Platform: " << q.get_device().get_platform().get_info<sycl::info::platform::name>() << std::endl
-              << "Compute Units: " << q.get_device().get_info<sycl::info::device::max_compute_units>() << std::endl
-              << "Memory Model: " << (is_usm_compatible ? "Unified Shared Memory" : "Generic Buffer") << std::endl
-              << std::endl;
+    for (auto& [title, prefix, save, bytes, func] : functions) {
+        // First call pays for first-touch allocations, and for JIT compilation
+        // unless the kernels were built at startup
+        auto start = ch::high_resolution_clock::now();
+        sycl::event::wait_and_throw(func());
+        auto first = elapsed(start);
+
+        for (size_t i = 0; i < settings.warmup; ++i) sycl::event::wait_and_throw(func());
+
+        std::vector<double> host_samples, device_samples;
+        host_samples.reserve(settings.rounds);
+        device_samples.reserve(settings.rounds);
+        for (size_t i = 0; i < settings.rounds; ++i) {
+            start = ch::high_resolution_clock::now();
+            auto events = func();
+            sycl::event::wait_and_throw(events);
+            host_samples.push_back(elapsed(start));
+            if (!events.empty())
+                device_samples.push_back(vn::device_milliseconds(events));
+        }
+
+        // Throughput from device time, or host time for host-only work
+        auto device = vn::summarize(device_samples);
+        auto host = vn::summarize(host_samples);
+        auto median = device.samples > 0 ? device.median : host.median;
+        auto pixels = static_cast<double>(input.shape[0]) * input.shape[1];
+        auto mpixs = median > 0 ? pixels / median * 1e-3 : 0.0;
+        auto gbs = median > 0 ? bytes / median * 1e-6 : 0.0;
+        records.push_back({ settings.label, memory, prefix, title, input.shape[1], input.shape[0], input.channels, bytes, settings.startup, first, device, host, mpixs, gbs });
+
+        auto& stats = device.samples > 0 ? device : host;
+        std::cout << title << ": " << stats.median << "ms median | " << stats.min << "ms min | " << stats.p95 << "ms p95 | " << stats.p99 << "ms p99"
+                  << (device.samples > 0 ? " (device)" : " (host)") << " | " << first << "ms first (" << settings.startup << ")";
+        if (bytes > 0)
+            std::cout << " | " << mpixs << " MPix/s | " << gbs << " GB/s";
+        std::cout << std::endl;
 
-    if (!is_usm_compatible) {
-        std::cerr << "Benchmark with Generic Buffer Memory Model is not possible yet." << std::endl;
-        return -1;
+        if (save && settings.save) save_func((settings.outpath.generic_string() + prefix + "-" + settings.inpath.filename().generic_string()).c_str());
     }
+}
 
+template <int channels>
+int benchmark(sycl::queue& q, vn::Image& input, const Settings& settings, std::vector<Record>& records) {
     // Benchmark function definitions
-    std::vector<std::tuple<std::string, std::string, bool, std::function<void(void)>>> functions;
+    BenchmarkList functions;
 
-    // Load image from provided path
-    auto input = vn::load_image(inpath.generic_string().c_str());
     auto output = vn::Image(input.shape[1], input.shape[0], input.channels);
-    auto channels = input.channels;
-
-    // Display Image information
-    std::cout << "Image Dimensions: " << input.shape[1] << 'x' << input.shape[0] << std::endl
-              << "Image Channels: " << input.channels << std::endl
-              << "Image Length: " << input.length << " bytes" << std::endl
-              << std::endl;
+    auto image_traffic = input.length + output.length;
 
     // Image shape definitions
     auto linear_shape = input.length / input.channels;
     auto bidimensional_shape = sycl::range<2>{ static_cast<size_t>(input.shape[0]), static_cast<size_t>(input.shape[1]) };
+    auto width = input.shape[1];
+    auto height = input.shape[0];
+
+    // Work-group tile for local memory stencil kernels
+    auto tile = sycl::range<2>{ vn::default_tile_size, vn::default_tile_size };
+    auto tiled_shape = vn::tiled_range(bidimensional_shape, tile);
+
+    // Device memory pool for images, masks and scratch buffers
+    auto pool = vn::MemoryPool(q);
 
     // Allocate memory for input and output images
-    auto in = sycl::malloc_device<uint8_t>(input.length, q);
-    auto out = sycl::malloc_device<uint8_t>(output.length, q);
+    auto in = pool.allocate<uint8_t>(input.length);
+    auto out = pool.allocate<uint8_t>(output.length);
     q.memcpy(in, input.data, input.length).wait_and_throw();
 
-    // Generic save image
-    auto save_func = [&output, &out, &q](std::string filepath) {
-        q.memcpy(output.data, out, output.length).wait_and_throw();
-        vn::save_image_as(filepath.c_str(), output);
+    // Generic save image, encoded in the background by the I/O stage
+    auto save_func = [&output, &out, &q, &settings](std::string filepath) {
+        auto result = vn::Image(output.shape[1], output.shape[0], output.channels);
+        q.memcpy(result.data, out, result.length).wait_and_throw();
+        settings.io->encode(filepath, std::move(result));
     };
 
     // Load image to device
     auto load_to_device = [&input, &in, &q] {
-        q.memcpy(in, input.data, input.length).wait_and_throw();
+        return Events{ q.memcpy(in, input.data, input.length) };
     };
-    functions.push_back({ "Load Image to Device", "load-to-device", false, load_to_device });
+    functions.push_back({ "Load Image to Device", "load-to-device", false, input.length, load_to_device });
 
     // Load image to host
     auto load_to_host = [&output, &out, &q] {
-        q.memcpy(output.data, out, output.length).wait_and_throw();
+        return Events{ q.memcpy(output.data, out, output.length) };
+    };
+    functions.push_back({ "Load Image to Host", "load-to-host", false, input.length, load_to_host });
+
+    // Load image to device from pinned host memory
+    auto pinned_input = input.clone(vn::Storage::pinned, q);
+    auto pinned_load_to_device = [&pinned_input, &in, &q] {
+        return Events{ q.memcpy(in, pinned_input.data, pinned_input.length) };
+    };
+    functions.push_back({ "Load Image to Device (Pinned Host Memory)", "pinned-load-to-device", false, input.length, pinned_load_to_device });
+
+    // Per-frame device allocation, straight from the runtime
+    auto runtime_allocation = [&input, &q] {
+        auto frame = sycl::malloc_device<uint8_t>(input.length, q);
+        sycl::free(frame, q);
+        return Events{};
+    };
+    functions.push_back({ "Device Frame Allocation (malloc_device)", "runtime-allocation", false, 0, runtime_allocation });
+
+    // Per-frame device allocation, recycled through the pool
+    auto pool_allocation = [&input, &pool] {
+        auto frame = pool.allocate<uint8_t>(input.length);
+        pool.deallocate(frame);
+        return Events{};
     };
-    functions.push_back({ "Load Image to Host", "load-to-host", false, load_to_host });
+    functions.push_back({ "Device Frame Allocation (Memory Pool)", "pool-allocation", false, 0, pool_allocation });
 
     // Inversion kernel
-    auto inversion_kernel = vn::InversionKernel<decltype(in), decltype(out)>(channels, in, out);
+    auto inversion_kernel = vn::InversionKernel<channels, decltype(in), decltype(out)>(in, out);
     auto inversion = [&in, &out, &q, &linear_shape, &inversion_kernel] {
-        q.parallel_for(linear_shape, inversion_kernel).wait_and_throw();
+        return Events{ q.parallel_for(linear_shape, inversion_kernel) };
     };
-    functions.push_back({ "Image Inversion", "inversion", true, inversion });
+    functions.push_back({ "Image Inversion", "inversion", true, image_traffic, inversion });
 
     // Grayscaling kernel
-    auto grayscale_kernel = vn::GrayscaleKernel<decltype(in), decltype(out)>(channels, in, out);
+    auto grayscale_kernel = vn::GrayscaleKernel<channels, decltype(in), decltype(out)>(in, out);
     auto grayscale = [&in, &out, &q, &linear_shape, &grayscale_kernel] {
-        q.parallel_for(linear_shape, grayscale_kernel).wait_and_throw();
+        return Events{ q.parallel_for(linear_shape, grayscale_kernel) };
     };
-    functions.push_back({ "Image Grayscaling", "grayscale", true, grayscale });
+    functions.push_back({ "Image Grayscaling", "grayscale", true, image_traffic, grayscale });
 
     // Threshold kernel for binary image
     constexpr unsigned char threshold_control = 128;
     constexpr unsigned char threshold_top = 255;
-    auto threshold_kernel = vn::ThresholdKernel<decltype(in), decltype(out), decltype(threshold_control)>(channels, in, out, threshold_control, threshold_top);
+    auto threshold_kernel = vn::ThresholdKernel<channels, decltype(in), decltype(out), decltype(threshold_control)>(in, out, threshold_control, threshold_top);
     auto threshold = [&in, &out, &q, &linear_shape, &threshold_kernel] {
-        q.parallel_for(linear_shape, threshold_kernel).wait_and_throw();
+        return Events{ q.parallel_for(linear_shape, threshold_kernel) };
+    };
+    functions.push_back({ "Image Thresholding", "threshold", true, image_traffic, threshold });
+
+    // Luminance histogram with work-group local bins, a few groups per compute unit
+    auto histogram_bins = pool.allocate<uint32_t>(vn::histogram_bins);
+    auto histogram_shape = vn::histogram_range(linear_shape, 4 * q.get_device().get_info<sycl::info::device::max_compute_units>());
+    auto histogram = [&in, &q, &linear_shape, &histogram_shape, &histogram_bins] {
+        auto clear = q.memset(histogram_bins, 0, vn::histogram_bins * sizeof(uint32_t));
+        return Events{ clear, q.submit([&](sycl::handler& h) {
+            h.depends_on(clear);
+            auto kernel = vn::HistogramKernel<channels, true, decltype(in), decltype(histogram_bins)>(h, in, histogram_bins, linear_shape);
+            h.parallel_for(histogram_shape, kernel);
+        }) };
+    };
+    functions.push_back({ "Image Histogram (Luminance, Local Atomics)", "histogram", false, input.length, histogram });
+
+    // Otsu threshold chosen on the device and read there by the threshold kernel
+    auto otsu_control = pool.allocate<int>(1);
+    auto otsu_kernel = vn::OtsuKernel<decltype(histogram_bins), decltype(otsu_control)>(histogram_bins, otsu_control);
+    auto otsu_threshold_kernel = vn::ThresholdKernel<channels, decltype(in), decltype(out), decltype(threshold_top), decltype(otsu_control)>(in, out, otsu_control, threshold_top);
+    auto otsu_threshold = [&q, &linear_shape, &histogram, &otsu_kernel, &otsu_threshold_kernel] {
+        auto events = histogram();
+        events.push_back(q.single_task(events.back(), otsu_kernel));
+        events.push_back(q.parallel_for(linear_shape, events.back(), otsu_threshold_kernel));
+        return events;
     };
-    functions.push_back({ "Image Thresholding", "threshold", true, threshold });
+    functions.push_back({ "Image Thresholding (Otsu)", "otsu-threshold", true, image_traffic, otsu_threshold });
 
     // Erode kernel for cross masking
     constexpr unsigned char erode_mask_array[] = { 0, 1, 0, 1, 1, 1, 0, 1, 0 };
@@ -140,13 +255,13 @@ int main(int argc, char** argv) {
     constexpr int erode_mask_width = 3;
     constexpr int erode_mask_height = 3;
     constexpr unsigned char erode_max = 255;
-    auto erode_mask = sycl::malloc_device<uint8_t>(erode_mask_length, q);
+    auto erode_mask = pool.allocate<uint8_t>(erode_mask_length);
     q.memcpy(erode_mask, erode_mask_array, erode_mask_length);
-    auto erode_kernel = vn::ErodeKernel<decltype(in), decltype(out), decltype(erode_mask), decltype(erode_max)>(channels, in, out, erode_mask, erode_mask_width, erode_mask_height, erode_max);
+    auto erode_kernel = vn::ErodeKernel<channels, decltype(in), decltype(out), decltype(erode_mask), decltype(erode_max)>(in, out, erode_mask, erode_mask_width, erode_mask_height, erode_max);
     auto erode = [&in, &out, &q, &bidimensional_shape, &erode_kernel] {
-        q.parallel_for(bidimensional_shape, erode_kernel).wait_and_throw();
+        return Events{ q.parallel_for(bidimensional_shape, erode_kernel) };
     };
-    functions.push_back({ "Image Eroding (Cross Mask)", "erode", true, erode });
+    functions.push_back({ "Image Eroding (Cross Mask)", "erode", true, image_traffic, erode });
 
     // Dilate kernel for cross masking
     constexpr unsigned char dilate_mask_array[] = { 0, 1, 0, 1, 1, 1, 0, 1, 0 };
@@ -154,13 +269,49 @@ int main(int argc, char** argv) {
     constexpr int dilate_mask_width = 3;
     constexpr int dilate_mask_height = 3;
     constexpr unsigned char dilate_min = 0;
-    auto dilate_mask = sycl::malloc_device<uint8_t>(dilate_mask_length, q);
+    auto dilate_mask = pool.allocate<uint8_t>(dilate_mask_length);
     q.memcpy(dilate_mask, dilate_mask_array, dilate_mask_length);
-    auto dilate_kernel = vn::DilateKernel<decltype(in), decltype(out), decltype(dilate_mask), decltype(dilate_min)>(channels, in, out, dilate_mask, dilate_mask_width, dilate_mask_height, dilate_min);
+    auto dilate_kernel = vn::DilateKernel<channels, decltype(in), decltype(out), decltype(dilate_mask), decltype(dilate_min)>(in, out, dilate_mask, dilate_mask_width, dilate_mask_height, dilate_min);
     auto dilate = [&in, &out, &q, &bidimensional_shape, &dilate_kernel] {
-        q.parallel_for(bidimensional_shape, dilate_kernel).wait_and_throw();
+        return Events{ q.parallel_for(bidimensional_shape, dilate_kernel) };
+    };
+    functions.push_back({ "Image Dilating (Cross Mask)", "dilate", true, image_traffic, dilate });
+
+    // Erode and dilate kernels for 15x15 rectangle masking
+    constexpr int rectangle_mask_width = 15;
+    constexpr int rectangle_mask_height = 15;
+    constexpr int rectangle_mask_length = rectangle_mask_width * rectangle_mask_height;
+    unsigned char rectangle_mask_array[rectangle_mask_length];
+    std::fill_n(rectangle_mask_array, rectangle_mask_length, 1);
+    auto rectangle_mask = pool.allocate<uint8_t>(rectangle_mask_length);
+    q.memcpy(rectangle_mask, rectangle_mask_array, rectangle_mask_length).wait_and_throw();
+    auto rectangle_erode_kernel = vn::ErodeKernel<channels, decltype(in), decltype(out), decltype(rectangle_mask), decltype(erode_max)>(in, out, rectangle_mask, rectangle_mask_width, rectangle_mask_height, erode_max);
+    auto rectangle_erode = [&in, &out, &q, &bidimensional_shape, &rectangle_erode_kernel] {
+        return Events{ q.parallel_for(bidimensional_shape, rectangle_erode_kernel) };
     };
-    functions.push_back({ "Image Dilating (Cross Mask)", "dilate", true, dilate });
+    functions.push_back({ "Image Eroding (15x15 Rectangle Mask)", "rectangle-erode", true, image_traffic, rectangle_erode });
+
+    auto rectangle_dilate_kernel = vn::DilateKernel<channels, decltype(in), decltype(out), decltype(rectangle_mask), decltype(dilate_min)>(in, out, rectangle_mask, rectangle_mask_width, rectangle_mask_height, dilate_min);
+    auto rectangle_dilate = [&in, &out, &q, &bidimensional_shape, &rectangle_dilate_kernel] {
+        return Events{ q.parallel_for(bidimensional_shape, rectangle_dilate_kernel) };
+    };
+    functions.push_back({ "Image Dilating (15x15 Rectangle Mask)", "rectangle-dilate", true, image_traffic, rectangle_dilate });
+
+    // van Herk/Gil-Werman erode and dilate for the same rectangle
+    if (!vn::is_rectangle_mask(rectangle_mask_array, rectangle_mask_width, rectangle_mask_height)) {
+        std::cerr << "Error: 15x15 mask is not a rectangle" << std::endl;
+        return 4;
+    }
+    auto rectangle_morphology = vn::RectangleMorphology<channels, uint8_t>(q, width, height, rectangle_mask_width, rectangle_mask_height, &pool);
+    auto vhgw_erode = [&in, &out, &rectangle_morphology] {
+        return Events{ rectangle_morphology.erode(in, out, erode_max) };
+    };
+    functions.push_back({ "Image Eroding (15x15 Rectangle Mask, van Herk/Gil-Werman)", "vhgw-erode", true, image_traffic, vhgw_erode });
+
+    auto vhgw_dilate = [&in, &out, &rectangle_morphology] {
+        return Events{ rectangle_morphology.dilate(in, out, dilate_min) };
+    };
+    functions.push_back({ "Image Dilating (15x15 Rectangle Mask, van Herk/Gil-Werman)", "vhgw-dilate", true, image_traffic, vhgw_dilate });
 
     // clang-format off
     // Convolution kernel for 3x3 Gaussian Blur
@@ -173,13 +324,13 @@ int main(int argc, char** argv) {
     constexpr int convolution_mask_width_blur_3x3 = 3;
     constexpr int convolution_mask_height_blur_3x3 = 3;
     constexpr int convolution_mask_length_blur_3x3 = convolution_mask_width_blur_3x3 * convolution_mask_height_blur_3x3;
-    auto convolution_mask_blur_3x3 = sycl::malloc_device<float>(convolution_mask_length_blur_3x3, q);
-    q.memcpy(convolution_mask_blur_3x3, convolution_mask_array_blur_3x3, convolution_mask_length_blur_3x3 * sizeof(decltype(convolution_mask_array_blur_3x3)));
-    auto convolution_kernel_blur_3x3 = vn::ConvolutionKernel<decltype(in), decltype(out), decltype(convolution_mask_blur_3x3), float, uint8_t>(channels, in, out, convolution_mask_blur_3x3, convolution_mask_width_blur_3x3, convolution_mask_height_blur_3x3);
+    auto convolution_mask_blur_3x3 = pool.allocate<float>(convolution_mask_length_blur_3x3);
+    q.memcpy(convolution_mask_blur_3x3, convolution_mask_array_blur_3x3, sizeof(convolution_mask_array_blur_3x3)).wait_and_throw();
+    auto convolution_kernel_blur_3x3 = vn::ConvolutionKernel<channels, decltype(in), decltype(out), decltype(convolution_mask_blur_3x3), float, uint8_t>(in, out, convolution_mask_blur_3x3, convolution_mask_width_blur_3x3, convolution_mask_height_blur_3x3);
     auto convolution_blur_3x3 = [&in, &out, &q, &bidimensional_shape, &convolution_kernel_blur_3x3] {
-        q.parallel_for(bidimensional_shape, convolution_kernel_blur_3x3).wait_and_throw();
+        return Events{ q.parallel_for(bidimensional_shape, convolution_kernel_blur_3x3) };
     };
-    functions.push_back({ "Image Convolution (Gaussian Blur 3x3 Kernel)", "convolution-blur-3", true, convolution_blur_3x3 });
+    functions.push_back({ "Image Convolution (Gaussian Blur 3x3 Kernel)", "convolution-blur-3", true, image_traffic, convolution_blur_3x3 });
 
     // clang-format off
     // Convolution kernel for 5x5 Gaussian Blur
@@ -194,47 +345,1538 @@ int main(int argc, char** argv) {
     constexpr int convolution_mask_width_blur_5x5 = 5;
     constexpr int convolution_mask_height_blur_5x5 = 5;
     constexpr int convolution_mask_length_blur_5x5 = convolution_mask_width_blur_5x5 * convolution_mask_height_blur_5x5;
-    auto convolution_mask_blur_5x5 = sycl::malloc_device<float>(convolution_mask_length_blur_5x5, q);
-    q.memcpy(convolution_mask_blur_5x5, convolution_mask_array_blur_5x5, convolution_mask_length_blur_5x5 * sizeof(decltype(convolution_mask_array_blur_5x5)));
-    auto convolution_kernel_blur_5x5 = vn::ConvolutionKernel<decltype(in), decltype(out), decltype(convolution_mask_blur_5x5), float, uint8_t>(channels, in, out, convolution_mask_blur_5x5, convolution_mask_width_blur_5x5, convolution_mask_height_blur_5x5);
+    auto convolution_mask_blur_5x5 = pool.allocate<float>(convolution_mask_length_blur_5x5);
+    q.memcpy(convolution_mask_blur_5x5, convolution_mask_array_blur_5x5, sizeof(convolution_mask_array_blur_5x5)).wait_and_throw();
+    auto convolution_kernel_blur_5x5 = vn::ConvolutionKernel<channels, decltype(in), decltype(out), decltype(convolution_mask_blur_5x5), float, uint8_t>(in, out, convolution_mask_blur_5x5, convolution_mask_width_blur_5x5, convolution_mask_height_blur_5x5);
     auto convolution_blur_5x5 = [&in, &out, &q, &bidimensional_shape, &convolution_kernel_blur_5x5] {
-        q.parallel_for(bidimensional_shape, convolution_kernel_blur_5x5).wait_and_throw();
+        return Events{ q.parallel_for(bidimensional_shape, convolution_kernel_blur_5x5) };
     };
-    functions.push_back({ "Image Convolution (Gaussian Blur 5x5 Kernel)", "convolution-blur-5", true, convolution_blur_5x5 });
+    functions.push_back({ "Image Convolution (Gaussian Blur 5x5 Kernel)", "convolution-blur-5", true, image_traffic, convolution_blur_5x5 });
+
+    // Intermediate buffer for separable convolution passes
+    auto separable_tmp = pool.allocate<float>(input.length);
+
+    // Separable convolution for 5x5 Gaussian Blur, factorised from the 2D mask
+    float separable_row_array_blur_5x5[convolution_mask_width_blur_5x5];
+    float separable_column_array_blur_5x5[convolution_mask_height_blur_5x5];
+    if (!vn::separate_mask(convolution_mask_array_blur_5x5, convolution_mask_width_blur_5x5, convolution_mask_height_blur_5x5, separable_row_array_blur_5x5, separable_column_array_blur_5x5)) {
+        std::cerr << "Error: Gaussian Blur 5x5 mask is not separable" << std::endl;
+        return 4;
+    }
+    auto separable_row_blur_5x5 = pool.allocate<float>(convolution_mask_width_blur_5x5);
+    auto separable_column_blur_5x5 = pool.allocate<float>(convolution_mask_height_blur_5x5);
+    q.memcpy(separable_row_blur_5x5, separable_row_array_blur_5x5, sizeof(separable_row_array_blur_5x5)).wait_and_throw();
+    q.memcpy(separable_column_blur_5x5, separable_column_array_blur_5x5, sizeof(separable_column_array_blur_5x5)).wait_and_throw();
+    auto row_convolution_kernel_blur_5x5 = vn::RowConvolutionKernel<channels, decltype(in), decltype(separable_tmp), decltype(separable_row_blur_5x5), float>(in, separable_tmp, separable_row_blur_5x5, convolution_mask_width_blur_5x5);
+    auto column_convolution_kernel_blur_5x5 = vn::ColumnConvolutionKernel<channels, decltype(separable_tmp), decltype(out), decltype(separable_column_blur_5x5), float, uint8_t>(separable_tmp, out, separable_column_blur_5x5, convolution_mask_height_blur_5x5);
+    auto separable_convolution_blur_5x5 = [&q, &bidimensional_shape, &row_convolution_kernel_blur_5x5, &column_convolution_kernel_blur_5x5] {
+        auto row = q.parallel_for(bidimensional_shape, row_convolution_kernel_blur_5x5);
+        auto column = q.parallel_for(bidimensional_shape, row, column_convolution_kernel_blur_5x5);
+        return Events{ row, column };
+    };
+    functions.push_back({ "Image Separable Convolution (Gaussian Blur 5x5 Kernel)", "separable-convolution-blur-5", true, image_traffic, separable_convolution_blur_5x5 });
+
+    // Convolution kernel for 15x15 Gaussian Blur, built as the outer product of a 1D Gaussian
+    constexpr int convolution_mask_width_blur_15x15 = 15;
+    constexpr int convolution_mask_height_blur_15x15 = 15;
+    constexpr int convolution_mask_length_blur_15x15 = convolution_mask_width_blur_15x15 * convolution_mask_height_blur_15x15;
+    constexpr float convolution_sigma_blur_15x15 = 2.5f;
+    float separable_vector_array_blur_15x15[convolution_mask_width_blur_15x15];
+    float convolution_mask_array_blur_15x15[convolution_mask_length_blur_15x15];
+    vn::gaussian_vector(convolution_mask_width_blur_15x15, convolution_sigma_blur_15x15, separable_vector_array_blur_15x15);
+    for (int i = 0; i < convolution_mask_width_blur_15x15; ++i)
+        for (int j = 0; j < convolution_mask_height_blur_15x15; ++j)
+            convolution_mask_array_blur_15x15[i * convolution_mask_height_blur_15x15 + j] = separable_vector_array_blur_15x15[i] * separable_vector_array_blur_15x15[j];
+    auto convolution_mask_blur_15x15 = pool.allocate<float>(convolution_mask_length_blur_15x15);
+    q.memcpy(convolution_mask_blur_15x15, convolution_mask_array_blur_15x15, sizeof(convolution_mask_array_blur_15x15)).wait_and_throw();
+    auto convolution_kernel_blur_15x15 = vn::ConvolutionKernel<channels, decltype(in), decltype(out), decltype(convolution_mask_blur_15x15), float, uint8_t>(in, out, convolution_mask_blur_15x15, convolution_mask_width_blur_15x15, convolution_mask_height_blur_15x15);
+    auto convolution_blur_15x15 = [&in, &out, &q, &bidimensional_shape, &convolution_kernel_blur_15x15] {
+        return Events{ q.parallel_for(bidimensional_shape, convolution_kernel_blur_15x15) };
+    };
+    functions.push_back({ "Image Convolution (Gaussian Blur 15x15 Kernel)", "convolution-blur-15", true, image_traffic, convolution_blur_15x15 });
+
+    // Separable convolution for 15x15 Gaussian Blur, straight from the 1D Gaussian
+    auto separable_vector_blur_15x15 = pool.allocate<float>(convolution_mask_width_blur_15x15);
+    q.memcpy(separable_vector_blur_15x15, separable_vector_array_blur_15x15, sizeof(separable_vector_array_blur_15x15)).wait_and_throw();
+    auto row_convolution_kernel_blur_15x15 = vn::RowConvolutionKernel<channels, decltype(in), decltype(separable_tmp), decltype(separable_vector_blur_15x15), float>(in, separable_tmp, separable_vector_blur_15x15, convolution_mask_width_blur_15x15);
+    auto column_convolution_kernel_blur_15x15 = vn::ColumnConvolutionKernel<channels, decltype(separable_tmp), decltype(out), decltype(separable_vector_blur_15x15), float, uint8_t>(separable_tmp, out, separable_vector_blur_15x15, convolution_mask_height_blur_15x15);
+    auto separable_convolution_blur_15x15 = [&q, &bidimensional_shape, &row_convolution_kernel_blur_15x15, &column_convolution_kernel_blur_15x15] {
+        auto row = q.parallel_for(bidimensional_shape, row_convolution_kernel_blur_15x15);
+        auto column = q.parallel_for(bidimensional_shape, row, column_convolution_kernel_blur_15x15);
+        return Events{ row, column };
+    };
+    functions.push_back({ "Image Separable Convolution (Gaussian Blur 15x15 Kernel)", "separable-convolution-blur-15", true, image_traffic, separable_convolution_blur_15x15 });
 
     // Direct Gaussian Blur 3x3 Kernel
-    auto gaussian_blur_3x3_kernel = vn::GaussianBlur3X3Kernel<decltype(in), decltype(out), uint8_t>(channels, in, out);
+    auto gaussian_blur_3x3_kernel = vn::GaussianBlur3X3Kernel<channels, decltype(in), decltype(out), uint8_t>(in, out);
     auto gaussian_blur_3x3 = [&in, &out, &q, &bidimensional_shape, &gaussian_blur_3x3_kernel] {
-        q.parallel_for(bidimensional_shape, gaussian_blur_3x3_kernel).wait_and_throw();
+        return Events{ q.parallel_for(bidimensional_shape, gaussian_blur_3x3_kernel) };
+    };
+    functions.push_back({ "Image Gaussian Blurring (3x3 Kernel)", "blur-3", true, image_traffic, gaussian_blur_3x3 });
+
+    // Fixed-point convolutions, integer weights scaled by 2^8 with rounded and saturated output
+    constexpr int fixed_point_shift = 8;
+    int16_t fixed_point_array_blur_3x3[convolution_mask_length_blur_3x3];
+    int16_t fixed_point_array_blur_5x5[convolution_mask_length_blur_5x5];
+    if (!vn::quantize_mask(convolution_mask_array_blur_3x3, convolution_mask_length_blur_3x3, fixed_point_shift, fixed_point_array_blur_3x3) ||
+        !vn::quantize_mask(convolution_mask_array_blur_5x5, convolution_mask_length_blur_5x5, fixed_point_shift, fixed_point_array_blur_5x5)) {
+        std::cerr << "Error: Gaussian Blur masks do not fit in 16-bit fixed point" << std::endl;
+        return 4;
+    }
+    auto fixed_point_mask_blur_3x3 = pool.allocate<int16_t>(convolution_mask_length_blur_3x3);
+    auto fixed_point_mask_blur_5x5 = pool.allocate<int16_t>(convolution_mask_length_blur_5x5);
+    q.memcpy(fixed_point_mask_blur_3x3, fixed_point_array_blur_3x3, sizeof(fixed_point_array_blur_3x3)).wait_and_throw();
+    q.memcpy(fixed_point_mask_blur_5x5, fixed_point_array_blur_5x5, sizeof(fixed_point_array_blur_5x5)).wait_and_throw();
+
+    auto fixed_point_convolution_kernel_blur_3x3 = vn::FixedPointConvolutionKernel<channels, decltype(in), decltype(out), decltype(fixed_point_mask_blur_3x3), int32_t>(in, out, fixed_point_mask_blur_3x3, convolution_mask_width_blur_3x3, convolution_mask_height_blur_3x3, fixed_point_shift);
+    auto fixed_point_convolution_blur_3x3 = [&q, &bidimensional_shape, &fixed_point_convolution_kernel_blur_3x3] {
+        return Events{ q.parallel_for(bidimensional_shape, fixed_point_convolution_kernel_blur_3x3) };
+    };
+    functions.push_back({ "Image Convolution (Gaussian Blur 3x3 Kernel, Fixed-Point)", "fixed-convolution-blur-3", true, image_traffic, fixed_point_convolution_blur_3x3 });
+
+    auto fixed_point_convolution_kernel_blur_5x5 = vn::FixedPointConvolutionKernel<channels, decltype(in), decltype(out), decltype(fixed_point_mask_blur_5x5), int32_t>(in, out, fixed_point_mask_blur_5x5, convolution_mask_width_blur_5x5, convolution_mask_height_blur_5x5, fixed_point_shift);
+    auto fixed_point_convolution_blur_5x5 = [&q, &bidimensional_shape, &fixed_point_convolution_kernel_blur_5x5] {
+        return Events{ q.parallel_for(bidimensional_shape, fixed_point_convolution_kernel_blur_5x5) };
+    };
+    functions.push_back({ "Image Convolution (Gaussian Blur 5x5 Kernel, Fixed-Point)", "fixed-convolution-blur-5", true, image_traffic, fixed_point_convolution_blur_5x5 });
+
+    // 16-bit accumulators are enough for the 3x3 blur at shift 4
+    auto fixed_point_gaussian_blur_3x3_kernel = vn::FixedPointGaussianBlur3X3Kernel<channels, decltype(in), decltype(out), int16_t>(in, out);
+    auto fixed_point_gaussian_blur_3x3 = [&q, &bidimensional_shape, &fixed_point_gaussian_blur_3x3_kernel] {
+        return Events{ q.parallel_for(bidimensional_shape, fixed_point_gaussian_blur_3x3_kernel) };
+    };
+    functions.push_back({ "Image Gaussian Blurring (3x3 Kernel, Fixed-Point)", "fixed-blur-3", true, image_traffic, fixed_point_gaussian_blur_3x3 });
+
+    // Integral image, rows scanned with work-group scans then columns summed
+    auto integral_sums = pool.allocate<uint32_t>(vn::integral_length<channels>(width, height));
+    auto integral_row_shape = vn::integral_row_range(height);
+    auto integral_column_shape = vn::integral_column_range<channels>(width);
+    auto integral_row_kernel = vn::IntegralRowKernel<channels, decltype(in), decltype(integral_sums)>(in, integral_sums, width);
+    auto integral_column_kernel = vn::IntegralColumnKernel<channels, decltype(integral_sums)>(integral_sums, height);
+    auto integral = [&q, &integral_row_shape, &integral_column_shape, &integral_row_kernel, &integral_column_kernel] {
+        auto rows = q.parallel_for(integral_row_shape, integral_row_kernel);
+        return Events{ rows, q.parallel_for(integral_column_shape, rows, integral_column_kernel) };
+    };
+    auto integral_traffic = input.length + 2 * vn::integral_length<channels>(width, height) * sizeof(uint32_t);
+    functions.push_back({ "Image Integral (Group Scan)", "integral", false, integral_traffic, integral });
+
+    // Box filters and local mean thresholds over the integral image, constant cost per pixel
+    constexpr int adaptive_threshold_offset = 5;
+    for (auto radius : { 15, 31 }) {
+        auto side = std::to_string(2 * radius + 1);
+        auto box_filter = [&q, &bidimensional_shape, &integral, &in, &out, &integral_sums, radius] {
+            auto events = integral();
+            auto kernel = vn::BoxFilterKernel<channels, decltype(in), decltype(integral_sums), decltype(out)>(in, integral_sums, out, radius);
+            events.push_back(q.parallel_for(bidimensional_shape, events.back(), kernel));
+            return events;
+        };
+        functions.push_back({ "Image Box Filtering (" + side + "x" + side + " Window, Integral Image)", "box-" + side, true, image_traffic, box_filter });
+
+        auto adaptive_threshold = [&q, &bidimensional_shape, &integral, &in, &out, &integral_sums, radius, threshold_top] {
+            auto events = integral();
+            auto kernel = vn::AdaptiveThresholdKernel<channels, decltype(in), decltype(integral_sums), decltype(out), decltype(threshold_top)>(in, integral_sums, out, radius, adaptive_threshold_offset, threshold_top);
+            events.push_back(q.parallel_for(bidimensional_shape, events.back(), kernel));
+            return events;
+        };
+        functions.push_back({ "Image Adaptive Thresholding (" + side + "x" + side + " Mean, Integral Image)", "adaptive-threshold-" + side, true, image_traffic, adaptive_threshold });
+    }
+
+    // Resizing to 60% of each side, saved separately since the output shape differs
+    auto resize_width = std::max(width * 3 / 5, 1);
+    auto resize_height = std::max(height * 3 / 5, 1);
+    auto resize_shape = sycl::range<2>{ static_cast<size_t>(resize_height), static_cast<size_t>(resize_width) };
+    auto resize_length = static_cast<size_t>(resize_width) * resize_height * channels;
+    auto resize_out = pool.allocate<uint8_t>(resize_length);
+    auto resize_traffic = input.length + resize_length;
+    auto bilinear_resize_kernel = vn::BilinearResizeKernel<channels, decltype(in), decltype(resize_out)>(in, resize_out, width, height);
+    auto bilinear_resize = [&q, &resize_shape, &bilinear_resize_kernel] {
+        return Events{ q.parallel_for(resize_shape, bilinear_resize_kernel) };
+    };
+    functions.push_back({ "Image Resizing (Bilinear, 60%)", "resize-bilinear", false, resize_traffic, bilinear_resize });
+
+    auto area_resize_kernel = vn::AreaResizeKernel<channels, decltype(in), decltype(resize_out)>(in, resize_out, width, height);
+    auto area_resize = [&q, &resize_shape, &area_resize_kernel] {
+        return Events{ q.parallel_for(resize_shape, area_resize_kernel) };
+    };
+    functions.push_back({ "Image Resizing (Area, 60%)", "resize-area", false, resize_traffic, area_resize });
+
+    // Gaussian pyramid, every level in one allocation and one fused blur + decimation launch per level
+    constexpr int pyramid_levels = 5;
+    auto pyramid_layout = vn::pyramid_layout(width, height, channels, pyramid_levels);
+    auto pyramid = pool.allocate<uint8_t>(vn::pyramid_length(pyramid_layout, channels));
+    auto gaussian_pyramid = [&q, &in, &input, &pyramid, &pyramid_layout] {
+        auto events = Events{ q.memcpy(pyramid, in, input.length) };
+        auto levels = vn::build_pyramid<channels>(q, pyramid, pyramid_layout, events);
+        events.insert(events.end(), levels.begin(), levels.end());
+        return events;
+    };
+    auto pyramid_traffic = 2 * vn::pyramid_length(pyramid_layout, channels);
+    functions.push_back({ "Gaussian Pyramid (" + std::to_string(pyramid_layout.size()) + " Levels, Fused Blur + Decimation)", "pyramid", false, pyramid_traffic, gaussian_pyramid });
+
+    // Single channel luminance output, a third of the grayscale output traffic for RGB
+    auto plane_length = linear_shape;
+    auto luminance_out = pool.allocate<uint8_t>(plane_length);
+    auto luminance_kernel = vn::LuminanceKernel<channels, decltype(in), decltype(luminance_out)>(in, luminance_out);
+    auto luminance = [&q, &linear_shape, &luminance_kernel] {
+        return Events{ q.parallel_for(linear_shape, luminance_kernel) };
+    };
+    functions.push_back({ "Image Grayscaling (Luminance, Single Channel)", "luminance", false, input.length + plane_length, luminance });
+
+    // Interleaved and planar conversions
+    auto planar_in = pool.allocate<uint8_t>(input.length);
+    auto planar_out = pool.allocate<uint8_t>(output.length);
+    auto deinterleave_kernel = vn::DeinterleaveKernel<channels, decltype(in), decltype(planar_in)>(in, planar_in);
+    auto deinterleave = [&q, &linear_shape, &deinterleave_kernel] {
+        return Events{ q.parallel_for(sycl::range<1>{ linear_shape }, deinterleave_kernel) };
+    };
+    functions.push_back({ "Interleaved to Planar Conversion", "deinterleave", false, image_traffic, deinterleave });
+    deinterleave().front().wait_and_throw();
+
+    auto interleave_kernel = vn::InterleaveKernel<channels, decltype(planar_out), decltype(out)>(planar_out, out);
+    auto interleave = [&q, &linear_shape, &interleave_kernel] {
+        return Events{ q.parallel_for(sycl::range<1>{ linear_shape }, interleave_kernel) };
+    };
+
+    // Planar kernels, every color plane handled as a single channel image and alpha copied through
+    constexpr int planar_colors = vn::color_channels<channels>;
+    auto copy_alpha = [&q, &planar_in, &planar_out, plane_length](Events& events) {
+        if constexpr (vn::has_alpha<channels>)
+            events.push_back(q.memcpy(vn::plane(planar_out, channels - 1, plane_length), vn::plane(planar_in, channels - 1, plane_length), plane_length));
+    };
+    auto planar_inversion_kernel = vn::InversionKernel<1, decltype(planar_in), decltype(planar_out)>(planar_in, planar_out);
+    auto planar_inversion = [&q, &planar_inversion_kernel, &copy_alpha, plane_length] {
+        auto events = Events{ q.parallel_for(sycl::range<1>{ planar_colors * plane_length }, planar_inversion_kernel) };
+        copy_alpha(events);
+        return events;
+    };
+    functions.push_back({ "Image Inversion (Planar)", "planar-inversion", false, image_traffic, planar_inversion });
+
+    auto planar_convolution_blur_5x5 = [&q, &bidimensional_shape, &planar_in, &planar_out, &convolution_mask_blur_5x5, &copy_alpha, plane_length] {
+        Events events;
+        for (int c = 0; c < planar_colors; ++c) {
+            auto plane_in = vn::plane(planar_in, c, plane_length);
+            auto plane_out = vn::plane(planar_out, c, plane_length);
+            auto kernel = vn::ConvolutionKernel<1, decltype(plane_in), decltype(plane_out), decltype(convolution_mask_blur_5x5), float, uint8_t>(plane_in, plane_out, convolution_mask_blur_5x5, convolution_mask_width_blur_5x5, convolution_mask_height_blur_5x5);
+            events.push_back(q.parallel_for(bidimensional_shape, kernel));
+        }
+        copy_alpha(events);
+        return events;
+    };
+    functions.push_back({ "Image Convolution (Gaussian Blur 5x5 Kernel, Planar)", "planar-convolution-blur-5", false, image_traffic, planar_convolution_blur_5x5 });
+
+    if constexpr (planar_colors == 3) {
+        auto planar_luminance_kernel = vn::PlanarLuminanceKernel<decltype(planar_in), decltype(luminance_out)>(planar_in, luminance_out);
+        auto planar_luminance = [&q, &linear_shape, planar_luminance_kernel] {
+            return Events{ q.parallel_for(sycl::range<1>{ linear_shape }, planar_luminance_kernel) };
+        };
+        functions.push_back({ "Image Grayscaling (Luminance, Planar)", "planar-luminance", false, 4 * plane_length, planar_luminance });
+    }
+
+    // Tiled erode kernel for cross masking
+    auto tiled_erode = [&in, &out, &q, &tile, &tiled_shape, &erode_mask, &width, &height] {
+        return Events{ q.submit([&](sycl::handler& h) {
+            auto kernel = vn::TiledErodeKernel<channels, decltype(in), decltype(out), decltype(erode_mask), decltype(erode_max)>(h, tile, in, out, erode_mask, erode_mask_width, erode_mask_height, width, height, erode_max);
+            h.parallel_for(tiled_shape, kernel);
+        }) };
+    };
+    functions.push_back({ "Image Eroding (Cross Mask, Tiled)", "tiled-erode", true, image_traffic, tiled_erode });
+
+    // Tiled dilate kernel for cross masking
+    auto tiled_dilate = [&in, &out, &q, &tile, &tiled_shape, &dilate_mask, &width, &height] {
+        return Events{ q.submit([&](sycl::handler& h) {
+            auto kernel = vn::TiledDilateKernel<channels, decltype(in), decltype(out), decltype(dilate_mask), decltype(dilate_min)>(h, tile, in, out, dilate_mask, dilate_mask_width, dilate_mask_height, width, height, dilate_min);
+            h.parallel_for(tiled_shape, kernel);
+        }) };
+    };
+    functions.push_back({ "Image Dilating (Cross Mask, Tiled)", "tiled-dilate", true, image_traffic, tiled_dilate });
+
+    // Unfused opening for cross masking: erode into a scratch image, then dilate it
+    auto morphology_tmp = pool.allocate<uint8_t>(input.length);
+    auto unfused_opening = [&in, &out, &q, &tile, &tiled_shape, &erode_mask, &dilate_mask, &morphology_tmp, &width, &height] {
+        auto eroded = q.submit([&](sycl::handler& h) {
+            auto kernel = vn::TiledErodeKernel<channels, decltype(in), decltype(morphology_tmp), decltype(erode_mask), decltype(erode_max)>(h, tile, in, morphology_tmp, erode_mask, erode_mask_width, erode_mask_height, width, height, erode_max);
+            h.parallel_for(tiled_shape, kernel);
+        });
+        auto dilated = q.submit([&](sycl::handler& h) {
+            h.depends_on(eroded);
+            auto kernel = vn::TiledDilateKernel<channels, decltype(morphology_tmp), decltype(out), decltype(dilate_mask), decltype(dilate_min)>(h, tile, morphology_tmp, out, dilate_mask, dilate_mask_width, dilate_mask_height, width, height, dilate_min);
+            h.parallel_for(tiled_shape, kernel);
+        });
+        return Events{ eroded, dilated };
+    };
+    functions.push_back({ "Image Opening (Cross Mask, Unfused)", "unfused-opening", true, 2 * image_traffic, unfused_opening });
+
+    // Fused compound morphology for cross masking, one launch each
+    auto compound = [&in, &out, &q, &tile, &tiled_shape, &erode_mask, &width, &height](auto operation) {
+        return Events{ q.submit([&](sycl::handler& h) {
+            auto kernel = vn::TiledCompoundMorphologyKernel<channels, decltype(in), decltype(out), decltype(erode_mask), uint8_t, decltype(operation)::value>(h, tile, in, out, erode_mask, erode_mask_width, erode_mask_height, width, height, dilate_min, erode_max);
+            h.parallel_for(tiled_shape, kernel);
+        }) };
+    };
+    using Operation = vn::MorphologyOperation;
+    auto opening = [&compound] { return compound(std::integral_constant<Operation, Operation::opening>()); };
+    functions.push_back({ "Image Opening (Cross Mask, Fused)", "opening", true, image_traffic, opening });
+    auto closing = [&compound] { return compound(std::integral_constant<Operation, Operation::closing>()); };
+    functions.push_back({ "Image Closing (Cross Mask, Fused)", "closing", true, image_traffic, closing });
+    auto gradient = [&compound] { return compound(std::integral_constant<Operation, Operation::gradient>()); };
+    functions.push_back({ "Image Morphological Gradient (Cross Mask, Fused)", "gradient", true, image_traffic, gradient });
+    auto top_hat = [&compound] { return compound(std::integral_constant<Operation, Operation::top_hat>()); };
+    functions.push_back({ "Image Top-Hat (Cross Mask, Fused)", "top-hat", true, image_traffic, top_hat });
+    auto black_hat = [&compound] { return compound(std::integral_constant<Operation, Operation::black_hat>()); };
+    functions.push_back({ "Image Black-Hat (Cross Mask, Fused)", "black-hat", true, image_traffic, black_hat });
+
+    // Erosion repeated five times on device, ping-ponging through a scratch image
+    constexpr int erode_iterations = 5;
+    auto iterated_morphology = vn::IteratedMorphology<channels, uint8_t>(q, width, height, tile, &pool);
+    auto iterated_erode = [&in, &out, &erode_mask, &iterated_morphology] {
+        return Events{ iterated_morphology.erode(in, out, erode_mask, erode_mask_width, erode_mask_height, erode_max, erode_iterations) };
+    };
+    functions.push_back({ "Image Eroding (Cross Mask, 5 Iterations)", "erode-5", true, erode_iterations * image_traffic, iterated_erode });
+
+    // Canny edges, gradient and suppression fused into one tiled kernel from
+    // the color input, hysteresis iterated on device into a single channel map
+    constexpr int canny_low = 50;
+    constexpr int canny_high = 150;
+    auto canny_out = pool.allocate<uint8_t>(plane_length);
+    auto canny_detector = vn::CannyDetector<channels, uint8_t>(q, width, height, tile, &pool);
+    auto canny = [&in, &canny_out, &canny_detector] {
+        return canny_detector.detect(in, canny_out, canny_low, canny_high);
+    };
+    functions.push_back({ "Canny Edge Detection (Sobel 3x3, Fused Suppression, Device Hysteresis)", "canny", false, input.length + plane_length, canny });
+
+    // Tiled convolution kernel for 3x3 Gaussian Blur
+    auto tiled_convolution_blur_3x3 = [&in, &out, &q, &tile, &tiled_shape, &convolution_mask_blur_3x3, &width, &height] {
+        return Events{ q.submit([&](sycl::handler& h) {
+            auto kernel = vn::TiledConvolutionKernel<channels, decltype(in), decltype(out), decltype(convolution_mask_blur_3x3), float, uint8_t>(h, tile, in, out, convolution_mask_blur_3x3, convolution_mask_width_blur_3x3, convolution_mask_height_blur_3x3, width, height);
+            h.parallel_for(tiled_shape, kernel);
+        }) };
+    };
+    functions.push_back({ "Image Convolution (Gaussian Blur 3x3 Kernel, Tiled)", "tiled-convolution-blur-3", true, image_traffic, tiled_convolution_blur_3x3 });
+
+    // Tiled convolution kernel for 5x5 Gaussian Blur
+    auto tiled_convolution_blur_5x5 = [&in, &out, &q, &tile, &tiled_shape, &convolution_mask_blur_5x5, &width, &height] {
+        return Events{ q.submit([&](sycl::handler& h) {
+            auto kernel = vn::TiledConvolutionKernel<channels, decltype(in), decltype(out), decltype(convolution_mask_blur_5x5), float, uint8_t>(h, tile, in, out, convolution_mask_blur_5x5, convolution_mask_width_blur_5x5, convolution_mask_height_blur_5x5, width, height);
+            h.parallel_for(tiled_shape, kernel);
+        }) };
+    };
+    functions.push_back({ "Image Convolution (Gaussian Blur 5x5 Kernel, Tiled)", "tiled-convolution-blur-5", true, image_traffic, tiled_convolution_blur_5x5 });
+
+    // Tiled direct Gaussian Blur 3x3 Kernel
+    auto tiled_gaussian_blur_3x3 = [&in, &out, &q, &tile, &tiled_shape, &width, &height] {
+        return Events{ q.submit([&](sycl::handler& h) {
+            auto kernel = vn::TiledGaussianBlur3X3Kernel<channels, decltype(in), decltype(out), uint8_t>(h, tile, in, out, width, height);
+            h.parallel_for(tiled_shape, kernel);
+        }) };
+    };
+    functions.push_back({ "Image Gaussian Blurring (3x3 Kernel, Tiled)", "tiled-blur-3", true, image_traffic, tiled_gaussian_blur_3x3 });
+
+    // Unfused point operation chain: grayscale, threshold and inversion as separate launches
+    auto chain_threshold_kernel = vn::ThresholdKernel<channels, decltype(out), decltype(out), decltype(threshold_control)>(out, out, threshold_control, threshold_top);
+    auto chain_inversion_kernel = vn::InversionKernel<channels, decltype(out), decltype(out)>(out, out);
+    auto unfused_chain = [&q, &linear_shape, &grayscale_kernel, &chain_threshold_kernel, &chain_inversion_kernel] {
+        auto grayscale = q.parallel_for(linear_shape, grayscale_kernel);
+        auto threshold = q.parallel_for(linear_shape, grayscale, chain_threshold_kernel);
+        auto inversion = q.parallel_for(linear_shape, threshold, chain_inversion_kernel);
+        return Events{ grayscale, threshold, inversion };
     };
-    functions.push_back({ "Image Gaussian Blurring (3x3 Kernel)", "blur-3", true, gaussian_blur_3x3 });
+    functions.push_back({ "Unfused Chain (Grayscale + Threshold + Inversion)", "unfused-chain", true, image_traffic, unfused_chain });
+
+    // Fused point operation chain: grayscale, threshold and inversion in one launch
+    auto fused_chain_op = vn::fuse(vn::GrayscaleOp(), vn::ThresholdOp<decltype(threshold_control)>(threshold_control, threshold_top), vn::InversionOp());
+    auto fused_chain_kernel = vn::FusedPointKernel<channels, decltype(in), decltype(out), decltype(fused_chain_op)>(in, out, fused_chain_op);
+    auto fused_chain = [&in, &out, &q, &linear_shape, &fused_chain_kernel] {
+        return Events{ q.parallel_for(linear_shape, fused_chain_kernel) };
+    };
+    functions.push_back({ "Fused Chain (Grayscale + Threshold + Inversion)", "fused-chain", true, image_traffic, fused_chain });
+
+    // Central region of interest, read in place from shared memory through a view
+    auto shared_input = input.clone(vn::Storage::shared, q);
+    auto roi = shared_input.roi(width / 4, height / 4, width / 2, height / 2);
+    auto roi_shape = sycl::range<2>{ static_cast<size_t>(roi.shape[0]), static_cast<size_t>(roi.shape[1]) };
+    auto roi_in = roi.data;
+    auto roi_out = pool.allocate<uint8_t>(roi.length);
+    auto roi_traffic = roi.length * 2;
+    auto roi_inversion_kernel = vn::StridedPointKernel<channels, vn::InversionKernel<channels, decltype(roi_in), decltype(roi_out)>>({ roi_in, roi_out }, roi.step[0], roi.shape[1] * channels);
+    auto roi_inversion = [&q, &roi_shape, &roi_inversion_kernel] {
+        return Events{ q.parallel_for(roi_shape, roi_inversion_kernel) };
+    };
+    functions.push_back({ "Image Inversion (Region of Interest View)", "roi-inversion", false, roi_traffic, roi_inversion });
+
+    auto roi_convolution_kernel_blur_5x5 = vn::ConvolutionKernel<channels, decltype(roi_in), decltype(roi_out), decltype(convolution_mask_blur_5x5), float, uint8_t>(roi_in, roi_out, convolution_mask_blur_5x5, convolution_mask_width_blur_5x5, convolution_mask_height_blur_5x5, roi.step[0]);
+    auto roi_convolution_blur_5x5 = [&q, &roi_shape, &roi_convolution_kernel_blur_5x5] {
+        return Events{ q.parallel_for(roi_shape, roi_convolution_kernel_blur_5x5) };
+    };
+    functions.push_back({ "Image Convolution (Gaussian Blur 5x5 Kernel, Region of Interest View)", "roi-convolution-blur-5", false, roi_traffic, roi_convolution_blur_5x5 });
 
     // Perform every benchmark
-    for (auto& [title, prefix, save, func] : functions) {
-        double delta_once, delta_total;
-        {
-            auto start = ch::high_resolution_clock::now();
-            func();
-            auto end = ch::high_resolution_clock::now();
-            delta_once = ch::duration_cast<ch::microseconds>(end - start).count() * 0.001;
+    run_benchmarks(functions, save_func, "usm", input, settings, records);
+
+    // Save the resized image and pyramid levels from their last runs
+    if (settings.save) {
+        auto save_shape = [&q, &settings](const std::string& prefix, const uint8_t* data, int shape_width, int shape_height, int shape_channels = channels) {
+            auto result = vn::Image(shape_width, shape_height, shape_channels);
+            q.memcpy(result.data, data, result.length).wait_and_throw();
+            settings.io->encode(settings.outpath.generic_string() + prefix + "-" + settings.inpath.filename().generic_string(), std::move(result));
+        };
+        bilinear_resize().front().wait_and_throw();
+        save_shape("resize-bilinear", resize_out, resize_width, resize_height);
+        area_resize().front().wait_and_throw();
+        save_shape("resize-area", resize_out, resize_width, resize_height);
+        for (size_t i = 1; i < pyramid_layout.size(); ++i)
+            save_shape("pyramid-" + std::to_string(i), pyramid + pyramid_layout[i].offset, pyramid_layout[i].width, pyramid_layout[i].height);
+        luminance().front().wait_and_throw();
+        save_shape("luminance", luminance_out, width, height, 1);
+        canny().back().wait_and_throw();
+        save_shape("canny", canny_out, width, height, 1);
+        for (auto [prefix, planar_func] : { std::pair<std::string, std::function<Events()>>{ "planar-inversion", planar_inversion }, { "planar-convolution-blur-5", planar_convolution_blur_5x5 } }) {
+            auto events = planar_func();
+            sycl::event::wait_and_throw(events);
+            interleave().front().wait_and_throw();
+            save_shape(prefix, out, width, height);
+        }
+    }
+
+    // Display the threshold Otsu's method picked for this image
+    int otsu_value = 0;
+    q.memcpy(&otsu_value, otsu_control, sizeof(otsu_value)).wait_and_throw();
+    std::cout << "Otsu Threshold: " << otsu_value << std::endl;
+    std::cout << "Canny Hysteresis: " << canny_detector.iterations() << " passes" << std::endl;
+
+    // Batched frame processing, blocking (depth 1) against overlapped (depth N)
+    if (settings.batch) {
+        constexpr size_t batch_frames = 32;
+        std::vector<vn::Image> batch_inputs, batch_outputs;
+        batch_inputs.reserve(batch_frames);
+        batch_outputs.reserve(batch_frames);
+        for (size_t i = 0; i < batch_frames; ++i) {
+            batch_inputs.emplace_back(width, height, channels);
+            batch_outputs.emplace_back(width, height, channels);
+            std::copy_n(input.data, input.length, batch_inputs.back().data);
         }
-        {
-            auto start = ch::high_resolution_clock::now();
-            for (size_t i = 0; i < rounds; ++i) func();
-            auto end = ch::high_resolution_clock::now();
-            delta_total = ch::duration_cast<ch::microseconds>(end - start).count() * 0.001;
+
+        auto batch_inversion = [&q, &linear_shape](uint8_t* in, uint8_t* out, const std::vector<sycl::event>& deps) {
+            auto kernel = vn::InversionKernel<channels, uint8_t*, uint8_t*>(in, out);
+            return q.parallel_for(linear_shape, deps, kernel);
+        };
+        auto batch_convolution_blur_5x5 = [&q, &bidimensional_shape, &convolution_mask_blur_5x5](uint8_t* in, uint8_t* out, const std::vector<sycl::event>& deps) {
+            auto kernel = vn::ConvolutionKernel<channels, uint8_t*, uint8_t*, decltype(convolution_mask_blur_5x5), float, uint8_t>(in, out, convolution_mask_blur_5x5, convolution_mask_width_blur_5x5, convolution_mask_height_blur_5x5);
+            return q.parallel_for(bidimensional_shape, deps, kernel);
+        };
+
+        for (auto batch_depth : { size_t{ 1 }, settings.depth }) {
+            auto processor = vn::BatchProcessor(q, input.length, output.length, batch_depth, &pool);
+            auto inversion_stats = processor.process(batch_inputs, batch_outputs, batch_inversion);
+            auto convolution_stats = processor.process(batch_inputs, batch_outputs, batch_convolution_blur_5x5);
+            std::cout << "Batch Image Inversion (" << batch_frames << " frames, depth " << batch_depth << "): "
+                      << inversion_stats.frames_per_second << " fps | " << inversion_stats.steady_frames_per_second << " fps (steady)" << std::endl;
+            std::cout << "Batch Image Convolution (Gaussian Blur 5x5 Kernel, " << batch_frames << " frames, depth " << batch_depth << "): "
+                      << convolution_stats.frames_per_second << " fps | " << convolution_stats.steady_frames_per_second << " fps (steady)" << std::endl;
         }
-        std::cout << title << ": " << delta_once << "ms (once) | " << delta_total << "ms (" << rounds << " times)" << std::endl;
-        if (save) save_func((outpath.generic_string() + prefix + "-" + inpath.filename().generic_string()).c_str());
     }
 
+    // Display memory pool counters
+    auto pool_stats = pool.stats();
+    std::cout << std::endl
+              << "Memory Pool: " << pool_stats.hits << " hits | " << pool_stats.misses << " misses | "
+              << pool_stats.high_water_mark << " bytes high-water mark | " << pool_stats.bytes_reserved << " bytes reserved" << std::endl;
+
     // Free all elements
-    sycl::free(in, q);
-    sycl::free(out, q);
-    sycl::free(erode_mask, q);
-    sycl::free(dilate_mask, q);
-    sycl::free(convolution_mask_blur_3x3, q);
+    pool.deallocate(in);
+    pool.deallocate(out);
+    pool.deallocate(histogram_bins);
+    pool.deallocate(otsu_control);
+    pool.deallocate(erode_mask);
+    pool.deallocate(dilate_mask);
+    pool.deallocate(rectangle_mask);
+    pool.deallocate(convolution_mask_blur_3x3);
+    pool.deallocate(convolution_mask_blur_5x5);
+    pool.deallocate(fixed_point_mask_blur_3x3);
+    pool.deallocate(fixed_point_mask_blur_5x5);
+    pool.deallocate(integral_sums);
+    pool.deallocate(resize_out);
+    pool.deallocate(pyramid);
+    pool.deallocate(luminance_out);
+    pool.deallocate(planar_in);
+    pool.deallocate(planar_out);
+    pool.deallocate(separable_tmp);
+    pool.deallocate(separable_row_blur_5x5);
+    pool.deallocate(separable_column_blur_5x5);
+    pool.deallocate(convolution_mask_blur_15x15);
+    pool.deallocate(separable_vector_blur_15x15);
+    pool.deallocate(roi_out);
+    pool.deallocate(morphology_tmp);
+    pool.deallocate(canny_out);
+
+    return 0;
+}
+
+// Same kernels through sycl::buffer and accessors, for devices without USM.
+// Buffers live for the whole run, so after the first launch the runtime
+// keeps the image on the device and only copies back on host access.
+template <int channels>
+int benchmark_buffer(sycl::queue& q, vn::Image& input, const Settings& settings, std::vector<Record>& records) {
+    // Benchmark function definitions
+    BenchmarkList functions;
+
+    auto output = vn::Image(input.shape[1], input.shape[0], input.channels);
+    auto image_traffic = input.length + output.length;
+
+    // Image shape definitions
+    auto linear_shape = sycl::range<1>{ input.length / input.channels };
+    auto bidimensional_shape = sycl::range<2>{ static_cast<size_t>(input.shape[0]), static_cast<size_t>(input.shape[1]) };
+
+    // Buffers for input and output images, the input is copied in and never written back
+    auto in_buffer = sycl::buffer<uint8_t, 1>{ static_cast<const uint8_t*>(input.data), sycl::range<1>{ input.length } };
+    auto out_buffer = sycl::buffer<uint8_t, 1>{ sycl::range<1>{ output.length } };
+
+    // Generic save image, encoded in the background by the I/O stage
+    auto save_func = [&output, &out_buffer, &settings](std::string filepath) {
+        auto result = vn::Image(output.shape[1], output.shape[0], output.channels);
+        sycl::host_accessor pixels{ out_buffer, sycl::read_only };
+        std::copy_n(pixels.get_pointer(), result.length, result.data);
+        settings.io->encode(filepath, std::move(result));
+    };
+
+    // Inversion kernel
+    auto inversion = [&q, &in_buffer, &out_buffer, &linear_shape] {
+        return Events{ q.submit([&](sycl::handler& h) {
+            sycl::accessor in{ in_buffer, h, sycl::read_only };
+            sycl::accessor out{ out_buffer, h, sycl::write_only, sycl::no_init };
+            h.parallel_for(linear_shape, vn::InversionKernel<channels, decltype(in), decltype(out)>(in, out));
+        }) };
+    };
+    functions.push_back({ "Image Inversion (Buffer)", "buffer-inversion", true, image_traffic, inversion });
+
+    // Grayscaling kernel
+    auto grayscale = [&q, &in_buffer, &out_buffer, &linear_shape] {
+        return Events{ q.submit([&](sycl::handler& h) {
+            sycl::accessor in{ in_buffer, h, sycl::read_only };
+            sycl::accessor out{ out_buffer, h, sycl::write_only, sycl::no_init };
+            h.parallel_for(linear_shape, vn::GrayscaleKernel<channels, decltype(in), decltype(out)>(in, out));
+        }) };
+    };
+    functions.push_back({ "Image Grayscaling (Buffer)", "buffer-grayscale", true, image_traffic, grayscale });
+
+    // Threshold kernel for binary image
+    constexpr unsigned char threshold_control = 128;
+    constexpr unsigned char threshold_top = 255;
+    auto threshold = [&q, &in_buffer, &out_buffer, &linear_shape] {
+        return Events{ q.submit([&](sycl::handler& h) {
+            sycl::accessor in{ in_buffer, h, sycl::read_only };
+            sycl::accessor out{ out_buffer, h, sycl::write_only, sycl::no_init };
+            h.parallel_for(linear_shape, vn::ThresholdKernel<channels, decltype(in), decltype(out), decltype(threshold_control)>(in, out, threshold_control, threshold_top));
+        }) };
+    };
+    functions.push_back({ "Image Thresholding (Buffer)", "buffer-threshold", true, image_traffic, threshold });
+
+    // Erode kernel for cross masking
+    constexpr unsigned char erode_mask_array[] = { 0, 1, 0, 1, 1, 1, 0, 1, 0 };
+    constexpr int erode_mask_length = 9;
+    constexpr int erode_mask_width = 3;
+    constexpr int erode_mask_height = 3;
+    constexpr unsigned char erode_max = 255;
+    auto erode_mask_buffer = sycl::buffer<uint8_t, 1>{ erode_mask_array, sycl::range<1>{ erode_mask_length } };
+    auto erode = [&q, &in_buffer, &out_buffer, &erode_mask_buffer, &bidimensional_shape] {
+        return Events{ q.submit([&](sycl::handler& h) {
+            sycl::accessor in{ in_buffer, h, sycl::read_only };
+            sycl::accessor out{ out_buffer, h, sycl::write_only, sycl::no_init };
+            sycl::accessor mask{ erode_mask_buffer, h, sycl::read_only };
+            h.parallel_for(bidimensional_shape, vn::ErodeKernel<channels, decltype(in), decltype(out), decltype(mask), decltype(erode_max)>(in, out, mask, erode_mask_width, erode_mask_height, erode_max));
+        }) };
+    };
+    functions.push_back({ "Image Eroding (Cross Mask, Buffer)", "buffer-erode", true, image_traffic, erode });
+
+    // Dilate kernel for cross masking
+    constexpr unsigned char dilate_mask_array[] = { 0, 1, 0, 1, 1, 1, 0, 1, 0 };
+    constexpr int dilate_mask_length = 9;
+    constexpr int dilate_mask_width = 3;
+    constexpr int dilate_mask_height = 3;
+    constexpr unsigned char dilate_min = 0;
+    auto dilate_mask_buffer = sycl::buffer<uint8_t, 1>{ dilate_mask_array, sycl::range<1>{ dilate_mask_length } };
+    auto dilate = [&q, &in_buffer, &out_buffer, &dilate_mask_buffer, &bidimensional_shape] {
+        return Events{ q.submit([&](sycl::handler& h) {
+            sycl::accessor in{ in_buffer, h, sycl::read_only };
+            sycl::accessor out{ out_buffer, h, sycl::write_only, sycl::no_init };
+            sycl::accessor mask{ dilate_mask_buffer, h, sycl::read_only };
+            h.parallel_for(bidimensional_shape, vn::DilateKernel<channels, decltype(in), decltype(out), decltype(mask), decltype(dilate_min)>(in, out, mask, dilate_mask_width, dilate_mask_height, dilate_min));
+        }) };
+    };
+    functions.push_back({ "Image Dilating (Cross Mask, Buffer)", "buffer-dilate", true, image_traffic, dilate });
+
+    // clang-format off
+    // Convolution kernel for 3x3 Gaussian Blur
+    constexpr float convolution_mask_array_blur_3x3[] = {
+        1.0f / 16.0f, 2.0f / 16.0f, 1.0f / 16.0f,
+        2.0f / 16.0f, 4.0f / 16.0f, 2.0f / 16.0f,
+        1.0f / 16.0f, 2.0f / 16.0f, 1.0f / 16.0f
+    };
+    // clang-format on
+    constexpr int convolution_mask_width_blur_3x3 = 3;
+    constexpr int convolution_mask_height_blur_3x3 = 3;
+    constexpr int convolution_mask_length_blur_3x3 = convolution_mask_width_blur_3x3 * convolution_mask_height_blur_3x3;
+    auto convolution_mask_buffer_blur_3x3 = sycl::buffer<float, 1>{ convolution_mask_array_blur_3x3, sycl::range<1>{ convolution_mask_length_blur_3x3 } };
+    auto convolution_blur_3x3 = [&q, &in_buffer, &out_buffer, &convolution_mask_buffer_blur_3x3, &bidimensional_shape] {
+        return Events{ q.submit([&](sycl::handler& h) {
+            sycl::accessor in{ in_buffer, h, sycl::read_only };
+            sycl::accessor out{ out_buffer, h, sycl::write_only, sycl::no_init };
+            sycl::accessor mask{ convolution_mask_buffer_blur_3x3, h, sycl::read_only };
+            h.parallel_for(bidimensional_shape, vn::ConvolutionKernel<channels, decltype(in), decltype(out), decltype(mask), float, uint8_t>(in, out, mask, convolution_mask_width_blur_3x3, convolution_mask_height_blur_3x3));
+        }) };
+    };
+    functions.push_back({ "Image Convolution (Gaussian Blur 3x3 Kernel, Buffer)", "buffer-convolution-blur-3", true, image_traffic, convolution_blur_3x3 });
+
+    // clang-format off
+    // Convolution kernel for 5x5 Gaussian Blur
+    constexpr float convolution_mask_array_blur_5x5[] = {
+        1.0f / 256.0f,  4.0f / 256.0f,  6.0f / 256.0f,  4.0f / 256.0f, 1.0f / 256.0f,
+        4.0f / 256.0f, 16.0f / 256.0f, 24.0f / 256.0f, 16.0f / 256.0f, 4.0f / 256.0f,
+        6.0f / 256.0f, 24.0f / 256.0f, 36.0f / 256.0f, 24.0f / 256.0f, 6.0f / 256.0f,
+        4.0f / 256.0f, 16.0f / 256.0f, 24.0f / 256.0f, 16.0f / 256.0f, 4.0f / 256.0f,
+        1.0f / 256.0f,  4.0f / 256.0f,  6.0f / 256.0f,  4.0f / 256.0f, 1.0f / 256.0f
+    };
+    // clang-format on
+    constexpr int convolution_mask_width_blur_5x5 = 5;
+    constexpr int convolution_mask_height_blur_5x5 = 5;
+    constexpr int convolution_mask_length_blur_5x5 = convolution_mask_width_blur_5x5 * convolution_mask_height_blur_5x5;
+    auto convolution_mask_buffer_blur_5x5 = sycl::buffer<float, 1>{ convolution_mask_array_blur_5x5, sycl::range<1>{ convolution_mask_length_blur_5x5 } };
+    auto convolution_blur_5x5 = [&q, &in_buffer, &out_buffer, &convolution_mask_buffer_blur_5x5, &bidimensional_shape] {
+        return Events{ q.submit([&](sycl::handler& h) {
+            sycl::accessor in{ in_buffer, h, sycl::read_only };
+            sycl::accessor out{ out_buffer, h, sycl::write_only, sycl::no_init };
+            sycl::accessor mask{ convolution_mask_buffer_blur_5x5, h, sycl::read_only };
+            h.parallel_for(bidimensional_shape, vn::ConvolutionKernel<channels, decltype(in), decltype(out), decltype(mask), float, uint8_t>(in, out, mask, convolution_mask_width_blur_5x5, convolution_mask_height_blur_5x5));
+        }) };
+    };
+    functions.push_back({ "Image Convolution (Gaussian Blur 5x5 Kernel, Buffer)", "buffer-convolution-blur-5", true, image_traffic, convolution_blur_5x5 });
+
+    // Direct Gaussian Blur 3x3 Kernel
+    auto gaussian_blur_3x3 = [&q, &in_buffer, &out_buffer, &bidimensional_shape] {
+        return Events{ q.submit([&](sycl::handler& h) {
+            sycl::accessor in{ in_buffer, h, sycl::read_only };
+            sycl::accessor out{ out_buffer, h, sycl::write_only, sycl::no_init };
+            h.parallel_for(bidimensional_shape, vn::GaussianBlur3X3Kernel<channels, decltype(in), decltype(out), uint8_t>(in, out));
+        }) };
+    };
+    functions.push_back({ "Image Gaussian Blurring (3x3 Kernel, Buffer)", "buffer-blur-3", true, image_traffic, gaussian_blur_3x3 });
+
+    // Unfused point operation chain, the runtime orders the launches through the output buffer
+    auto unfused_chain = [&q, &in_buffer, &out_buffer, &linear_shape] {
+        auto grayscale = q.submit([&](sycl::handler& h) {
+            sycl::accessor in{ in_buffer, h, sycl::read_only };
+            sycl::accessor out{ out_buffer, h, sycl::write_only, sycl::no_init };
+            h.parallel_for(linear_shape, vn::GrayscaleKernel<channels, decltype(in), decltype(out)>(in, out));
+        });
+        auto threshold = q.submit([&](sycl::handler& h) {
+            sycl::accessor out{ out_buffer, h, sycl::read_write };
+            h.parallel_for(linear_shape, vn::ThresholdKernel<channels, decltype(out), decltype(out), decltype(threshold_control)>(out, out, threshold_control, threshold_top));
+        });
+        auto inversion = q.submit([&](sycl::handler& h) {
+            sycl::accessor out{ out_buffer, h, sycl::read_write };
+            h.parallel_for(linear_shape, vn::InversionKernel<channels, decltype(out), decltype(out)>(out, out));
+        });
+        return Events{ grayscale, threshold, inversion };
+    };
+    functions.push_back({ "Unfused Chain (Grayscale + Threshold + Inversion, Buffer)", "buffer-unfused-chain", true, image_traffic, unfused_chain });
+
+    // Perform every benchmark
+    run_benchmarks(functions, save_func, "buffer", input, settings, records);
+
+    return 0;
+}
+
+// 5x5 convolution split into horizontal bands over every usable device, CPUs
+// divided into their NUMA domains, with band heights rebalanced after each
+// round from the measured throughput of every device
+template <int channels>
+int benchmark_split(vn::Image& input, const Settings& settings, std::vector<Record>& records) {
+    auto devices = vn::row_split_devices(vn::priority_backend_selector_v);
+    if (devices.empty())
+        return 0;
+
+    // Benchmark function definitions
+    BenchmarkList functions;
+
+    auto executor = vn::RowSplitExecutor(devices);
+
+    // Executor queues need not share the main queue context, so kernels are built for each of them too
+    std::vector<vn::KernelBuild> kernels;
+    if (settings.startup == "prebuilt")
+        for (auto& queue : executor.devices()) kernels.push_back(vn::build_kernels(queue));
+    auto output = vn::Image(input.shape[1], input.shape[0], input.channels);
+    auto image_traffic = input.length + output.length;
+    auto width = static_cast<size_t>(input.shape[1]);
+
+    // Generic save image, encoded in the background by the I/O stage
+    auto save_func = [&output, &settings](std::string filepath) {
+        settings.io->encode(filepath, output.clone());
+    };
+
+    // clang-format off
+    // Convolution kernel for 5x5 Gaussian Blur
+    constexpr float convolution_mask_array_blur_5x5[] = {
+        1.0f / 256.0f,  4.0f / 256.0f,  6.0f / 256.0f,  4.0f / 256.0f, 1.0f / 256.0f,
+        4.0f / 256.0f, 16.0f / 256.0f, 24.0f / 256.0f, 16.0f / 256.0f, 4.0f / 256.0f,
+        6.0f / 256.0f, 24.0f / 256.0f, 36.0f / 256.0f, 24.0f / 256.0f, 6.0f / 256.0f,
+        4.0f / 256.0f, 16.0f / 256.0f, 24.0f / 256.0f, 16.0f / 256.0f, 4.0f / 256.0f,
+        1.0f / 256.0f,  4.0f / 256.0f,  6.0f / 256.0f,  4.0f / 256.0f, 1.0f / 256.0f
+    };
+    // clang-format on
+    constexpr int convolution_mask_width_blur_5x5 = 5;
+    constexpr int convolution_mask_height_blur_5x5 = 5;
+    constexpr int convolution_mask_length_blur_5x5 = convolution_mask_width_blur_5x5 * convolution_mask_height_blur_5x5;
+    auto convolution_masks_blur_5x5 = executor.broadcast(convolution_mask_array_blur_5x5, convolution_mask_length_blur_5x5);
+    auto convolution_band_blur_5x5 = [&convolution_masks_blur_5x5, width](size_t index, sycl::queue& q, uint8_t* in, uint8_t* out, int rows, const std::vector<sycl::event>& deps) {
+        auto kernel = vn::ConvolutionKernel<channels, uint8_t*, uint8_t*, float*, float, uint8_t>(in, out, convolution_masks_blur_5x5[index], convolution_mask_width_blur_5x5, convolution_mask_height_blur_5x5);
+        return q.parallel_for(sycl::range<2>{ static_cast<size_t>(rows), width }, deps, kernel);
+    };
+    auto convolution_blur_5x5 = [&executor, &input, &output, &convolution_band_blur_5x5] {
+        executor.run(input, output, convolution_mask_height_blur_5x5 / 2, convolution_band_blur_5x5);
+        return Events{};
+    };
+    auto title = "Image Convolution (Gaussian Blur 5x5 Kernel, Row-Split over " + std::to_string(executor.size()) + " Devices)";
+    functions.push_back({ title, "row-split-convolution-blur-5", true, image_traffic, convolution_blur_5x5 });
+
+    // Perform every benchmark
+    run_benchmarks(functions, save_func, "row-split", input, settings, records);
+
+    // Display the split the executor settled on
+    for (size_t i = 0; i < executor.size(); ++i) {
+        auto& band = executor.last_bands()[i];
+        std::cout << "  Device " << i << " (" << executor.devices()[i].get_device().get_info<sycl::info::device::name>() << "): "
+                  << band.rows << " rows from row " << band.first_row;
+        if (band.milliseconds > 0)
+            std::cout << " | " << band.rows / band.milliseconds << " rows/ms";
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
+
+// Same convolution streamed through a bounded device memory budget, half
+// of input plus output unless --budget is given, so even small inputs are
+// processed in several bands
+template <int channels>
+int benchmark_stream(sycl::queue& q, vn::Image& input, const Settings& settings, std::vector<Record>& records) {
+    // Benchmark function definitions
+    BenchmarkList functions;
+
+    auto output = vn::Image(input.shape[1], input.shape[0], input.channels);
+    auto image_traffic = input.length + output.length;
+    auto width = static_cast<size_t>(input.shape[1]);
+    auto budget = settings.budget > 0 ? settings.budget : (input.length + output.length) / 2;
+    auto executor = vn::StreamingExecutor(q, budget);
+
+    // Generic save image, encoded in the background by the I/O stage
+    auto save_func = [&output, &settings](std::string filepath) {
+        settings.io->encode(filepath, output.clone());
+    };
+
+    // clang-format off
+    // Convolution kernel for 5x5 Gaussian Blur
+    constexpr float convolution_mask_array_blur_5x5[] = {
+        1.0f / 256.0f,  4.0f / 256.0f,  6.0f / 256.0f,  4.0f / 256.0f, 1.0f / 256.0f,
+        4.0f / 256.0f, 16.0f / 256.0f, 24.0f / 256.0f, 16.0f / 256.0f, 4.0f / 256.0f,
+        6.0f / 256.0f, 24.0f / 256.0f, 36.0f / 256.0f, 24.0f / 256.0f, 6.0f / 256.0f,
+        4.0f / 256.0f, 16.0f / 256.0f, 24.0f / 256.0f, 16.0f / 256.0f, 4.0f / 256.0f,
+        1.0f / 256.0f,  4.0f / 256.0f,  6.0f / 256.0f,  4.0f / 256.0f, 1.0f / 256.0f
+    };
+    // clang-format on
+    constexpr int convolution_mask_width_blur_5x5 = 5;
+    constexpr int convolution_mask_height_blur_5x5 = 5;
+    constexpr int convolution_mask_length_blur_5x5 = convolution_mask_width_blur_5x5 * convolution_mask_height_blur_5x5;
+    auto convolution_mask_blur_5x5 = sycl::malloc_device<float>(convolution_mask_length_blur_5x5, q);
+    q.memcpy(convolution_mask_blur_5x5, convolution_mask_array_blur_5x5, sizeof(convolution_mask_array_blur_5x5)).wait_and_throw();
+    auto convolution_band_blur_5x5 = [&convolution_mask_blur_5x5, width](sycl::queue& q, uint8_t* in, uint8_t* out, int rows, const std::vector<sycl::event>& deps) {
+        auto kernel = vn::ConvolutionKernel<channels, uint8_t*, uint8_t*, float*, float, uint8_t>(in, out, convolution_mask_blur_5x5, convolution_mask_width_blur_5x5, convolution_mask_height_blur_5x5);
+        return q.parallel_for(sycl::range<2>{ static_cast<size_t>(rows), width }, deps, kernel);
+    };
+    vn::StreamStats stats{};
+    auto convolution_blur_5x5 = [&executor, &input, &output, &stats, &convolution_band_blur_5x5] {
+        stats = executor.run(input, output, convolution_mask_height_blur_5x5 / 2, convolution_band_blur_5x5);
+        return Events{};
+    };
+    functions.push_back({ "Image Convolution (Gaussian Blur 5x5 Kernel, Streamed Bands)", "stream-convolution-blur-5", true, image_traffic, convolution_blur_5x5 });
+
+    // Perform every benchmark
+    try {
+        run_benchmarks(functions, save_func, "stream", input, settings, records);
+    } catch (std::invalid_argument const& ex) {
+        std::cerr << "Warning: skipping streamed bands: " << ex.what() << std::endl;
+    }
+    if (stats.bands > 0)
+        std::cout << "  " << stats.bands << " bands of " << stats.band_rows << " rows in " << stats.device_bytes << " bytes of device memory (budget " << budget << ")" << std::endl;
+
     sycl::free(convolution_mask_blur_5x5, q);
 
     return 0;
 }
+
+// Kernels instantiated for 16-bit or float elements. The input, whatever its
+// own pixel type, is converted to T on the device first; results are
+// converted back to the input type for saving, as PNM for 16-bit inputs and
+// raw for float ones, since the other writers only take 8 bits.
+template <int channels, typename T>
+int benchmark_depth(sycl::queue& q, vn::Image& input, const Settings& settings, std::vector<Record>& records) {
+    // Benchmark function definitions
+    BenchmarkList functions;
+
+    auto depth = std::string(vn::pixel_type_name(vn::pixel_type_of<T>));
+    auto width = input.shape[1];
+    auto height = input.shape[0];
+    auto elements = static_cast<size_t>(width) * height * channels;
+    auto depth_length = elements * sizeof(T);
+    auto image_traffic = 2 * depth_length;
+    auto linear_shape = sycl::range<1>{ static_cast<size_t>(width) * height };
+    auto bidimensional_shape = sycl::range<2>{ static_cast<size_t>(height), static_cast<size_t>(width) };
+
+    // Device memory pool for images, masks and scratch buffers
+    auto pool = vn::MemoryPool(q);
+    auto source = pool.allocate<uint8_t>(input.length);
+    auto in = pool.allocate<T>(elements);
+    auto out = pool.allocate<T>(elements);
+    auto tmp = pool.allocate<T>(elements);
+    q.memcpy(source, input.data, input.length).wait_and_throw();
+
+    // Conversions between the input type and T, in either direction
+    auto convert = [&q, &linear_shape, &source, &input](T* image, bool to_depth) {
+        sycl::event e;
+        vn::with_pixel_type(input.type, [&](auto s) {
+            using S = typename decltype(s)::type;
+            auto pixels = reinterpret_cast<S*>(source);
+            if (to_depth)
+                e = q.parallel_for(linear_shape, vn::ConvertKernel<channels, S*, T*>(pixels, image));
+            else
+                e = q.parallel_for(linear_shape, vn::ConvertKernel<channels, T*, S*>(image, pixels));
+        });
+        return e;
+    };
+    convert(in, true).wait_and_throw();
+
+    // Saved in the input type, with an extension whose writer takes it
+    auto save_func = [&q, &input, &source, &out, &convert, &settings](std::string filepath) {
+        auto result = vn::Image(input.shape[1], input.shape[0], input.channels, input.type);
+        convert(out, false).wait_and_throw();
+        q.memcpy(result.data, source, result.length).wait_and_throw();
+        if (input.type != vn::PixelType::uint8)
+            filepath = fs::path(filepath).replace_extension(input.type == vn::PixelType::uint16 ? ".pnm" : ".raw").generic_string();
+        settings.io->encode(filepath, std::move(result));
+    };
+
+    // Conversion of the input to T
+    auto convert_input = [&convert, &in] {
+        return Events{ convert(in, true) };
+    };
+    functions.push_back({ "Pixel Type Conversion (to " + depth + ")", "convert-" + depth, false, input.length + depth_length, convert_input });
+
+    // Inversion against the full scale of T
+    auto inversion_kernel = vn::InversionKernel<channels, decltype(in), decltype(out)>(in, out);
+    auto inversion = [&q, &linear_shape, &inversion_kernel] {
+        return Events{ q.parallel_for(linear_shape, inversion_kernel) };
+    };
+    functions.push_back({ "Image Inversion (" + depth + ")", "inversion-" + depth, true, image_traffic, inversion });
+
+    // Grayscale
+    auto grayscale_kernel = vn::GrayscaleKernel<channels, decltype(in), decltype(out)>(in, out);
+    auto grayscale = [&q, &linear_shape, &grayscale_kernel] {
+        return Events{ q.parallel_for(linear_shape, grayscale_kernel) };
+    };
+    functions.push_back({ "Image Grayscaling (" + depth + ")", "grayscale-" + depth, true, image_traffic, grayscale });
+
+    // Threshold at half scale
+    constexpr T threshold_control = vn::pixel_max<T> / 2;
+    constexpr T threshold_top = vn::pixel_max<T>;
+    auto threshold_kernel = vn::ThresholdKernel<channels, decltype(in), decltype(out), T>(in, out, threshold_control, threshold_top);
+    auto threshold = [&q, &linear_shape, &threshold_kernel] {
+        return Events{ q.parallel_for(linear_shape, threshold_kernel) };
+    };
+    functions.push_back({ "Image Threshold (" + depth + ")", "threshold-" + depth, true, image_traffic, threshold });
+
+    // Erosion with a cross mask
+    constexpr unsigned char erode_mask_array[] = { 0, 1, 0, 1, 1, 1, 0, 1, 0 };
+    constexpr int erode_mask_length = 9;
+    constexpr int erode_mask_width = 3;
+    constexpr int erode_mask_height = 3;
+    constexpr T erode_max = std::numeric_limits<T>::max();
+    auto erode_mask = pool.allocate<uint8_t>(erode_mask_length);
+    q.memcpy(erode_mask, erode_mask_array, erode_mask_length).wait_and_throw();
+    auto erode_kernel = vn::ErodeKernel<channels, decltype(in), decltype(out), decltype(erode_mask), T>(in, out, erode_mask, erode_mask_width, erode_mask_height, erode_max);
+    auto erode = [&q, &bidimensional_shape, &erode_kernel] {
+        return Events{ q.parallel_for(bidimensional_shape, erode_kernel) };
+    };
+    functions.push_back({ "Image Eroding (Cross Mask, " + depth + ")", "erode-" + depth, true, image_traffic, erode });
+
+    // clang-format off
+    // Convolution kernel for 5x5 Gaussian Blur
+    constexpr float convolution_mask_array_blur_5x5[] = {
+        1.0f / 256.0f,  4.0f / 256.0f,  6.0f / 256.0f,  4.0f / 256.0f, 1.0f / 256.0f,
+        4.0f / 256.0f, 16.0f / 256.0f, 24.0f / 256.0f, 16.0f / 256.0f, 4.0f / 256.0f,
+        6.0f / 256.0f, 24.0f / 256.0f, 36.0f / 256.0f, 24.0f / 256.0f, 6.0f / 256.0f,
+        4.0f / 256.0f, 16.0f / 256.0f, 24.0f / 256.0f, 16.0f / 256.0f, 4.0f / 256.0f,
+        1.0f / 256.0f,  4.0f / 256.0f,  6.0f / 256.0f,  4.0f / 256.0f, 1.0f / 256.0f
+    };
+    // clang-format on
+    constexpr int convolution_mask_width_blur_5x5 = 5;
+    constexpr int convolution_mask_height_blur_5x5 = 5;
+    constexpr int convolution_mask_length_blur_5x5 = convolution_mask_width_blur_5x5 * convolution_mask_height_blur_5x5;
+    auto convolution_mask_blur_5x5 = pool.allocate<float>(convolution_mask_length_blur_5x5);
+    q.memcpy(convolution_mask_blur_5x5, convolution_mask_array_blur_5x5, sizeof(convolution_mask_array_blur_5x5)).wait_and_throw();
+    auto convolution_kernel_blur_5x5 = vn::ConvolutionKernel<channels, decltype(in), decltype(out), decltype(convolution_mask_blur_5x5), float, T>(in, out, convolution_mask_blur_5x5, convolution_mask_width_blur_5x5, convolution_mask_height_blur_5x5);
+    auto convolution_blur_5x5 = [&q, &bidimensional_shape, &convolution_kernel_blur_5x5] {
+        return Events{ q.parallel_for(bidimensional_shape, convolution_kernel_blur_5x5) };
+    };
+    functions.push_back({ "Image Convolution (Gaussian Blur 5x5 Kernel, " + depth + ")", "convolution-blur-5-" + depth, true, image_traffic, convolution_blur_5x5 });
+
+    // Three blurs chained through a T intermediate, quantized only by the
+    // final conversion when saved
+    constexpr int chain_length = 3;
+    auto chain_first = vn::ConvolutionKernel<channels, decltype(in), decltype(out), decltype(convolution_mask_blur_5x5), float, T>(in, out, convolution_mask_blur_5x5, convolution_mask_width_blur_5x5, convolution_mask_height_blur_5x5);
+    auto chain_second = vn::ConvolutionKernel<channels, decltype(out), decltype(tmp), decltype(convolution_mask_blur_5x5), float, T>(out, tmp, convolution_mask_blur_5x5, convolution_mask_width_blur_5x5, convolution_mask_height_blur_5x5);
+    auto chain_third = vn::ConvolutionKernel<channels, decltype(tmp), decltype(out), decltype(convolution_mask_blur_5x5), float, T>(tmp, out, convolution_mask_blur_5x5, convolution_mask_width_blur_5x5, convolution_mask_height_blur_5x5);
+    auto chained_blur_5x5 = [&q, &bidimensional_shape, &chain_first, &chain_second, &chain_third] {
+        auto first = q.parallel_for(bidimensional_shape, chain_first);
+        auto second = q.parallel_for(bidimensional_shape, first, chain_second);
+        return Events{ first, second, q.parallel_for(bidimensional_shape, second, chain_third) };
+    };
+    functions.push_back({ "Image Convolution (Gaussian Blur 5x5 Kernel, 3 Chained, " + depth + ")", "convolution-blur-5-chain-" + depth, true, chain_length * image_traffic, chained_blur_5x5 });
+
+    // Perform every benchmark
+    run_benchmarks(functions, save_func, "usm-" + depth, input, settings, records);
+
+    // Free all elements
+    pool.deallocate(source);
+    pool.deallocate(in);
+    pool.deallocate(out);
+    pool.deallocate(tmp);
+    pool.deallocate(erode_mask);
+    pool.deallocate(convolution_mask_blur_5x5);
+
+    return 0;
+}
+
+// Encode and decode cost of each on-disk format. Loads include a copy into
+// contiguous memory so mapped files are actually paged in.
+int benchmark_io(vn::Image& input, const Settings& settings, std::vector<Record>& records) {
+    // Benchmark function definitions
+    BenchmarkList functions;
+
+    auto stem = fs::path(settings.label).stem().generic_string();
+    for (auto [format, extension] : { std::pair{ "PNG, stb_image", ".png" }, std::pair{ "PPM/PAM, mmap", ".ppm" }, std::pair{ "Raw, mmap", ".raw" } }) {
+        auto filepath = (settings.outpath / ("io-" + stem + extension)).generic_string();
+
+        auto save = [&input, filepath] {
+            if (!vn::save_image_as(filepath.c_str(), input))
+                throw std::runtime_error("could not write " + filepath);
+            return Events{};
+        };
+        functions.push_back({ std::string("Image Save (") + format + ")", std::string("save-") + (extension + 1), false, input.length, save });
+
+        auto load = [filepath] {
+            auto image = vn::load_image(filepath.c_str());
+            auto copy = image.clone();
+            return Events{};
+        };
+        functions.push_back({ std::string("Image Load (") + format + ")", std::string("load-") + (extension + 1), false, input.length, load });
+    }
+
+    // Perform every benchmark
+    run_benchmarks(functions, {}, "host", input, settings, records);
+
+    return 0;
+}
+
+// Decode, invert on the device and encode every file, first one after another
+// on this thread, then with the codec work spread over the I/O stage threads
+int benchmark_stage(sycl::queue& q, const std::vector<std::string>& filepaths, const Settings& settings) {
+    auto pool = vn::MemoryPool(q);
+    auto output_path = [&settings, &filepaths](size_t index) {
+        auto filename = "stage-" + std::to_string(index) + "-" + fs::path(filepaths[index]).filename().generic_string();
+        return (settings.outpath / filename).generic_string();
+    };
+
+    auto process = [&q, &pool](vn::Image& frame) {
+        if (!frame.is_contiguous())
+            frame = frame.clone();
+
+        // Frames keep their own pixel type, which may differ from the input image
+        auto result = vn::Image(frame.shape[1], frame.shape[0], frame.channels, frame.type);
+        auto memory = pool.allocate(frame.length);
+        auto upload = q.memcpy(memory, frame.data, frame.length);
+        auto count = frame.length / vn::pixel_size(frame.type) / frame.channels;
+        sycl::event compute;
+        vn::with_pixel_type(frame.type, [&](auto s) {
+            using S = typename decltype(s)::type;
+            auto pixels = static_cast<S*>(memory);
+            vn::with_channels(frame.channels, [&](auto c) {
+                auto kernel = vn::InversionKernel<decltype(c)::value, S*, S*>(pixels, pixels);
+                compute = q.parallel_for(sycl::range<1>{ count }, upload, kernel);
+            });
+        });
+        q.memcpy(result.data, memory, result.length, compute).wait_and_throw();
+        pool.deallocate(memory);
+        return result;
+    };
+
+    auto elapsed = [](ch::high_resolution_clock::time_point start) {
+        return ch::duration<double>(ch::high_resolution_clock::now() - start).count();
+    };
+
+    auto start = ch::high_resolution_clock::now();
+    for (size_t i = 0; i < filepaths.size(); ++i) {
+        auto frame = vn::load_image(filepaths[i].c_str());
+        auto result = process(frame);
+        vn::save_image_as(output_path(i).c_str(), result);
+    }
+    auto serial = elapsed(start);
+
+    start = ch::high_resolution_clock::now();
+    settings.io->decode(filepaths, [&](size_t index, vn::Image frame) {
+        settings.io->encode(output_path(index), process(frame));
+    });
+    auto failures = settings.io->flush();
+    auto overlapped = elapsed(start);
+
+    std::cout << "I/O Stage Image Inversion (" << filepaths.size() << " frames, serial): " << filepaths.size() / serial << " fps" << std::endl
+              << "I/O Stage Image Inversion (" << filepaths.size() << " frames, " << settings.io->threads() << " threads): " << filepaths.size() / overlapped << " fps" << std::endl;
+
+    if (failures > 0) {
+        std::cerr << "Error: " << failures << " frames could not be written" << std::endl;
+        return 6;
+    }
+    return 0;
+}
+
+// Deterministic noise, so sweeps at the same size always process the same pixels
+vn::Image synthetic_image(int width, int height, int channels) {
+    auto image = vn::Image(width, height, channels);
+    auto engine = std::minstd_rand(width * 31 + height);
+    for (unsigned long i = 0; i < image.length; ++i)
+        image.data[i] = static_cast<unsigned char>(engine() >> 8);
+    return image;
+}
+
+// Host cost per frame of a four kernel chain on a VGA frame, submitted step
+// by step as the benchmark lambdas do, against one recorded pipeline replay
+template <int channels>
+int benchmark_pipeline(sycl::queue& q, const Settings& settings, std::vector<Record>& records) {
+    constexpr int pipeline_width = 640;
+    constexpr int pipeline_height = 480;
+    constexpr unsigned char threshold_control = 128;
+    constexpr unsigned char threshold_top = 255;
+
+    // Benchmark function definitions
+    BenchmarkList functions;
+
+    auto input = synthetic_image(pipeline_width, pipeline_height, channels);
+    auto image_traffic = 2 * input.length;
+    auto linear_shape = input.length / channels;
+    auto bidimensional_shape = sycl::range<2>{ static_cast<size_t>(pipeline_height), static_cast<size_t>(pipeline_width) };
+    auto pipeline_settings = settings;
+    pipeline_settings.label = "synthetic-" + std::to_string(pipeline_width) + "x" + std::to_string(pipeline_height);
+    pipeline_settings.save = false;
+
+    // Two frame slots, so replays alternate between input/output pairs
+    auto pool = vn::MemoryPool(q);
+    uint8_t* ins[] = { pool.allocate<uint8_t>(input.length), pool.allocate<uint8_t>(input.length) };
+    uint8_t* outs[] = { pool.allocate<uint8_t>(input.length), pool.allocate<uint8_t>(input.length) };
+    auto tmp = pool.allocate<uint8_t>(input.length);
+    for (auto in : ins) q.memcpy(in, input.data, input.length);
+    q.wait_and_throw();
+
+    // Blur, grayscale, threshold and invert
+    std::vector<vn::Pipeline::Step> steps = {
+        [bidimensional_shape](sycl::handler& h, uint8_t* in, uint8_t* out) {
+            h.parallel_for(bidimensional_shape, vn::GaussianBlur3X3Kernel<channels, uint8_t*, uint8_t*, uint8_t>(in, out));
+        },
+        [linear_shape](sycl::handler& h, uint8_t* in, uint8_t* out) {
+            h.parallel_for(linear_shape, vn::GrayscaleKernel<channels, uint8_t*, uint8_t*>(in, out));
+        },
+        [linear_shape](sycl::handler& h, uint8_t* in, uint8_t* out) {
+            h.parallel_for(linear_shape, vn::ThresholdKernel<channels, uint8_t*, uint8_t*, unsigned char>(in, out, threshold_control, threshold_top));
+        },
+        [linear_shape](sycl::handler& h, uint8_t* in, uint8_t* out) {
+            h.parallel_for(linear_shape, vn::InversionKernel<channels, uint8_t*, uint8_t*>(in, out));
+        }
+    };
+
+    // Every step resubmitted per frame, chained by events on the main queue
+    size_t submitted_frame = 0;
+    auto submitted = [&q, &steps, &ins, &outs, &tmp, &submitted_frame] {
+        auto slot = submitted_frame++ % 2;
+        auto src = ins[slot];
+        sycl::event e;
+        for (size_t k = 0; k < steps.size(); ++k) {
+            auto dst = (steps.size() - 1 - k) % 2 == 0 ? outs[slot] : tmp;
+            e = q.submit([&](sycl::handler& h) {
+                if (k > 0)
+                    h.depends_on(e);
+                steps[k](h, src, dst);
+            });
+            src = dst;
+        }
+        e.wait_and_throw();
+        return Events{};
+    };
+    functions.push_back({ "Pipeline (Blur 3x3 + Grayscale + Threshold + Inversion, 640x480, Submitted)", "pipeline-submitted", false, image_traffic, submitted });
+
+    // Recorded once, replayed per frame with only the pointers swapped
+    auto pipeline = vn::Pipeline(q, input.length, &pool);
+    for (auto& step : steps) pipeline.add(step);
+    pipeline.finalize();
+    size_t replayed_frame = 0;
+    auto replayed = [&pipeline, &ins, &outs, &replayed_frame] {
+        auto slot = replayed_frame++ % 2;
+        pipeline.replay(ins[slot], outs[slot]).wait_and_throw();
+        return Events{};
+    };
+    auto title = std::string("Pipeline (Blur 3x3 + Grayscale + Threshold + Inversion, 640x480, Replayed, ") + (pipeline.uses_graph() ? "Command Graph" : "In-Order Queue") + ")";
+    functions.push_back({ title, "pipeline-replayed", false, image_traffic, replayed });
+
+    // Perform every benchmark
+    run_benchmarks(functions, [](std::string) {}, "pipeline", input, pipeline_settings, records);
+
+    // Both paths must agree on the last frame of each slot
+    std::vector<uint8_t> expected(input.length), actual(input.length);
+    for (size_t slot = 0; slot < 2; ++slot) {
+        submitted();
+        q.memcpy(expected.data(), outs[slot], input.length).wait_and_throw();
+        pipeline.replay(ins[slot], outs[slot]).wait_and_throw();
+        q.memcpy(actual.data(), outs[slot], input.length).wait_and_throw();
+        if (expected != actual) {
+            std::cerr << "Error: replayed pipeline output differs from submitted kernels" << std::endl;
+            return 4;
+        }
+    }
+
+    for (auto in : ins) pool.deallocate(in);
+    for (auto out : outs) pool.deallocate(out);
+    pool.deallocate(tmp);
+
+    return 0;
+}
+
+// Host backend against the device, copies and wait included, on square
+// synthetic frames of doubling side. Each processing kernel gets its own
+// crossover, and the input image is then dispatched by it.
+template <int channels>
+int benchmark_dispatch(sycl::queue& q, const vn::Image& input) {
+    constexpr size_t min_side = 8;
+    constexpr size_t max_side = 1024;
+    constexpr unsigned char threshold_control = 128;
+    constexpr unsigned char threshold_top = 255;
+    constexpr unsigned char erode_max = 255;
+    constexpr unsigned char dilate_min = 0;
+
+    auto frame = synthetic_image(max_side, max_side, channels);
+    auto result = vn::Image(max_side, max_side, channels);
+    auto pool = vn::MemoryPool(q);
+    auto device_in = pool.allocate<uint8_t>(frame.length);
+    auto device_out = pool.allocate<uint8_t>(frame.length);
+    std::vector<size_t> sizes;
+    for (auto side = min_side; side <= max_side; side *= 2) sizes.push_back(side * side);
+    auto side_of = [](size_t pixels) {
+        return static_cast<size_t>(std::lround(std::sqrt(static_cast<double>(pixels))));
+    };
+
+    // Masks live on both sides, so host and device kernels have the same type
+    constexpr unsigned char cross_mask_array[] = { 0, 1, 0, 1, 1, 1, 0, 1, 0 };
+    constexpr int cross_mask_width = 3;
+    constexpr int cross_mask_height = 3;
+    const uint8_t* host_cross_mask = cross_mask_array;
+    auto cross_mask = pool.allocate<uint8_t>(sizeof(cross_mask_array));
+    q.memcpy(cross_mask, cross_mask_array, sizeof(cross_mask_array)).wait_and_throw();
+    const uint8_t* device_cross_mask = cross_mask;
+
+    // clang-format off
+    constexpr float blur_mask_array[] = {
+        1.0f / 256.0f,  4.0f / 256.0f,  6.0f / 256.0f,  4.0f / 256.0f, 1.0f / 256.0f,
+        4.0f / 256.0f, 16.0f / 256.0f, 24.0f / 256.0f, 16.0f / 256.0f, 4.0f / 256.0f,
+        6.0f / 256.0f, 24.0f / 256.0f, 36.0f / 256.0f, 24.0f / 256.0f, 6.0f / 256.0f,
+        4.0f / 256.0f, 16.0f / 256.0f, 24.0f / 256.0f, 16.0f / 256.0f, 4.0f / 256.0f,
+        1.0f / 256.0f,  4.0f / 256.0f,  6.0f / 256.0f,  4.0f / 256.0f, 1.0f / 256.0f
+    };
+    // clang-format on
+    constexpr int blur_mask_width = 5;
+    constexpr int blur_mask_height = 5;
+    const float* host_blur_mask = blur_mask_array;
+    auto blur_mask = pool.allocate<float>(blur_mask_width * blur_mask_height);
+    q.memcpy(blur_mask, blur_mask_array, sizeof(blur_mask_array)).wait_and_throw();
+    const float* device_blur_mask = blur_mask;
+
+    vn::Dispatcher dispatcher;
+    auto input_pixels = static_cast<size_t>(input.shape[0]) * input.shape[1];
+    auto report = [&dispatcher, &side_of, input_pixels, &input](const std::string& title, const std::string& operation) {
+        auto crossover = dispatcher.crossover(operation);
+        std::cout << "Host/Device Crossover (" << title << "): ";
+        if (crossover > max_side * max_side)
+            std::cout << "host up to " << max_side << 'x' << max_side << ", device beyond (not measured)";
+        else
+            std::cout << "device from " << side_of(crossover) << 'x' << side_of(crossover) << " (" << crossover << " pixels)";
+        std::cout << " | " << input.shape[1] << 'x' << input.shape[0] << " input runs on "
+                  << (dispatcher.choose(operation, input_pixels) == vn::Backend::host ? "host" : "device") << std::endl;
+    };
+
+    // kernel_for(in, out, on_device) builds the kernel for either side
+    auto calibrate_point = [&](const std::string& title, const std::string& operation, auto kernel_for) {
+        auto host = [&](size_t pixels) {
+            vn::host_point<channels>(kernel_for(frame.data, result.data, false), pixels);
+        };
+        auto device = [&](size_t pixels) {
+            auto bytes = pixels * channels;
+            auto upload = q.memcpy(device_in, frame.data, bytes);
+            auto compute = q.parallel_for(sycl::range<1>{ pixels }, upload, kernel_for(device_in, device_out, true));
+            q.memcpy(result.data, device_out, bytes, compute).wait_and_throw();
+        };
+        dispatcher.calibrate(operation, sizes, host, device);
+        report(title, operation);
+    };
+    auto calibrate_stencil = [&](const std::string& title, const std::string& operation, auto kernel_for) {
+        auto host = [&](size_t pixels) {
+            auto side = side_of(pixels);
+            vn::host_stencil(kernel_for(frame.data, result.data, false), side, side);
+        };
+        auto device = [&](size_t pixels) {
+            auto side = side_of(pixels);
+            auto bytes = pixels * channels;
+            auto upload = q.memcpy(device_in, frame.data, bytes);
+            auto compute = q.parallel_for(sycl::range<2>{ side, side }, upload, kernel_for(device_in, device_out, true));
+            q.memcpy(result.data, device_out, bytes, compute).wait_and_throw();
+        };
+        dispatcher.calibrate(operation, sizes, host, device);
+        report(title, operation);
+    };
+
+    calibrate_point("Image Inversion", "inversion", [](uint8_t* in, uint8_t* out, bool) {
+        return vn::InversionKernel<channels, uint8_t*, uint8_t*>(in, out);
+    });
+    calibrate_point("Image Grayscaling", "grayscale", [](uint8_t* in, uint8_t* out, bool) {
+        return vn::GrayscaleKernel<channels, uint8_t*, uint8_t*>(in, out);
+    });
+    calibrate_point("Image Thresholding", "threshold", [](uint8_t* in, uint8_t* out, bool) {
+        return vn::ThresholdKernel<channels, uint8_t*, uint8_t*, unsigned char>(in, out, threshold_control, threshold_top);
+    });
+    calibrate_stencil("Image Eroding (Cross Mask)", "erode", [&](uint8_t* in, uint8_t* out, bool on_device) {
+        auto& mask = on_device ? device_cross_mask : host_cross_mask;
+        return vn::ErodeKernel<channels, uint8_t*, uint8_t*, const uint8_t*, unsigned char>(in, out, mask, cross_mask_width, cross_mask_height, erode_max);
+    });
+    calibrate_stencil("Image Dilating (Cross Mask)", "dilate", [&](uint8_t* in, uint8_t* out, bool on_device) {
+        auto& mask = on_device ? device_cross_mask : host_cross_mask;
+        return vn::DilateKernel<channels, uint8_t*, uint8_t*, const uint8_t*, unsigned char>(in, out, mask, cross_mask_width, cross_mask_height, dilate_min);
+    });
+    calibrate_stencil("Image Convolution (Gaussian Blur 5x5 Kernel)", "convolution-blur-5", [&](uint8_t* in, uint8_t* out, bool on_device) {
+        auto& mask = on_device ? device_blur_mask : host_blur_mask;
+        return vn::ConvolutionKernel<channels, uint8_t*, uint8_t*, const float*, float, uint8_t>(in, out, mask, blur_mask_width, blur_mask_height);
+    });
+    calibrate_stencil("Image Gaussian Blurring (3x3 Kernel)", "blur-3", [](uint8_t* in, uint8_t* out, bool) {
+        return vn::GaussianBlur3X3Kernel<channels, uint8_t*, uint8_t*, uint8_t>(in, out);
+    });
+
+    pool.deallocate(device_in);
+    pool.deallocate(device_out);
+    pool.deallocate(cross_mask);
+    pool.deallocate(blur_mask);
+
+    return 0;
+}
+
+std::string quote_csv(const std::string& value) {
+    std::string quoted = "\"";
+    for (auto c : value) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    return quoted + '"';
+}
+
+std::string quote_json(const std::string& value) {
+    std::string quoted = "\"";
+    for (auto c : value) {
+        if (c == '"' || c == '\\') quoted += '\\';
+        quoted += c;
+    }
+    return quoted + '"';
+}
+
+bool write_csv(const fs::path& path, const std::vector<Record>& records) {
+    std::ofstream file(path);
+    if (!file)
+        return false;
+
+    file << "label,memory,benchmark,title,width,height,channels,bytes,startup,first_ms,"
+            "device_samples,device_min_ms,device_mean_ms,device_median_ms,device_p95_ms,device_p99_ms,device_max_ms,"
+            "host_samples,host_min_ms,host_mean_ms,host_median_ms,host_p95_ms,host_p99_ms,host_max_ms,"
+            "mpix_per_s,gb_per_s\n";
+    for (auto& r : records) {
+        file << quote_csv(r.label) << ',' << r.memory << ',' << r.prefix << ',' << quote_csv(r.title) << ','
+             << r.width << ',' << r.height << ',' << r.channels << ',' << r.bytes << ',' << r.startup << ',' << r.first;
+        for (auto& stats : { r.device, r.host })
+            file << ',' << stats.samples << ',' << stats.min << ',' << stats.mean << ',' << stats.median << ',' << stats.p95 << ',' << stats.p99 << ',' << stats.max;
+        file << ',' << r.megapixels_per_second << ',' << r.gigabytes_per_second << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+bool write_json(const fs::path& path, const std::string& device, const std::vector<Record>& records) {
+    std::ofstream file(path);
+    if (!file)
+        return false;
+
+    auto stats_json = [](const vn::LatencyStats& stats) {
+        return "{ \"samples\": " + std::to_string(stats.samples) + ", \"min_ms\": " + std::to_string(stats.min) + ", \"mean_ms\": " + std::to_string(stats.mean) +
+               ", \"median_ms\": " + std::to_string(stats.median) + ", \"p95_ms\": " + std::to_string(stats.p95) + ", \"p99_ms\": " + std::to_string(stats.p99) +
+               ", \"max_ms\": " + std::to_string(stats.max) + " }";
+    };
+
+    file << "{\n  \"device\": " << quote_json(device) << ",\n  \"records\": [";
+    for (size_t i = 0; i < records.size(); ++i) {
+        auto& r = records[i];
+        file << (i == 0 ? "\n" : ",\n")
+             << "    { \"label\": " << quote_json(r.label) << ", \"memory\": " << quote_json(r.memory) << ", \"benchmark\": " << quote_json(r.prefix)
+             << ", \"title\": " << quote_json(r.title) << ", \"width\": " << r.width << ", \"height\": " << r.height << ", \"channels\": " << r.channels
+             << ", \"bytes\": " << r.bytes << ", \"startup\": " << quote_json(r.startup) << ", \"first_ms\": " << r.first << ", \"device\": " << stats_json(r.device) << ", \"host\": " << stats_json(r.host)
+             << ", \"mpix_per_s\": " << r.megapixels_per_second << ", \"gb_per_s\": " << r.gigabytes_per_second << " }";
+    }
+    file << "\n  ]\n}\n";
+    return static_cast<bool>(file);
+}
+
+// Counts include byte budgets, so they are parsed to the full size_t range.
+// stoull wraps negative numbers around, hence the explicit sign check.
+size_t parse_count(const char* value, const char* name, size_t fallback, size_t minimum = 1) {
+    auto arg = std::string(value);
+    try {
+        std::size_t pos;
+        auto count = std::stoull(arg, &pos);
+
+        if (pos < arg.size() || arg.find('-') != std::string::npos || count < minimum) {
+            std::cerr << "Error: " << name << " must be a number of at least " << minimum << std::endl;
+            return fallback;
+        }
+        return count;
+    } catch (std::invalid_argument const& ex) {
+        std::cerr << "Error: " << name << " is an invalid argument" << std::endl;
+    } catch (std::out_of_range const& ex) {
+        std::cerr << "Error: " << name << " is out of range" << std::endl;
+    }
+    return fallback;
+}
+
+int main(int argc, char** argv) {
+    constexpr const size_t default_rounds = 1000;
+    constexpr const size_t default_depth = 3;
+    constexpr const size_t default_warmup = 10;
+    constexpr const int sweep_min = 256;
+    constexpr const size_t default_stage_frames = 16;
+    size_t rounds = default_rounds;
+    size_t depth = default_depth;
+    size_t warmup = default_warmup;
+    size_t sweep_max = 0;
+    size_t io_threads = 0;
+    size_t budget = 0;
+    bool cold = false;
+    fs::path csv_path, json_path, frames_path;
+
+    // Split options from positional arguments
+    std::vector<char*> args;
+    for (int i = 1; i < argc; ++i) {
+        auto arg = std::string(argv[i]);
+        auto has_value = i + 1 < argc;
+        if (arg == "--warmup" && has_value)
+            warmup = parse_count(argv[++i], "--warmup", default_warmup, 0);
+        else if (arg == "--sweep" && has_value)
+            sweep_max = parse_count(argv[++i], "--sweep", 0, sweep_min);
+        else if (arg == "--csv" && has_value)
+            csv_path = argv[++i];
+        else if (arg == "--json" && has_value)
+            json_path = argv[++i];
+        else if (arg == "--frames" && has_value)
+            frames_path = argv[++i];
+        else if (arg == "--io-threads" && has_value)
+            io_threads = parse_count(argv[++i], "--io-threads", 0);
+        else if (arg == "--budget" && has_value)
+            budget = parse_count(argv[++i], "--budget", 0);
+        else if (arg == "--cold")
+            cold = true;
+        else
+            args.push_back(argv[i]);
+    }
+
+    // Ensure correct number of arguments
+    if (args.size() < 2 || args.size() > 4 || (!args.empty() && std::string(args.back()).rfind("--", 0) == 0)) {
+        std::cerr << "Usage: " << argv[0] << " [INPUT IMAGE] [OUTPUT PATH] [[ROUNDS] = " << rounds << "] [[BATCH DEPTH] = " << depth << "]" << std::endl
+                  << "       [--warmup N = " << warmup << "] [--sweep MAX SIDE] [--csv FILE] [--json FILE] [--frames DIRECTORY] [--io-threads N] [--budget BYTES] [--cold]" << std::endl;
+        return 1;
+    }
+
+    // Ensure rounds and batch depth are numbers
+    if (args.size() >= 3)
+        rounds = parse_count(args[2], "[ROUNDS]", default_rounds);
+    if (args.size() == 4)
+        depth = parse_count(args[3], "[BATCH DEPTH]", default_depth);
+
+    // Ensure input and output are valid
+    fs::path inpath(args[0]);
+    if (!inpath.has_filename()) {
+        std::cerr << "Error: [INPUT IMAGE] must be an image file, e.g. JPG or PNG" << std::endl;
+        return 2;
+    }
+    fs::path outpath(args[1]);
+    if (outpath.has_filename()) {
+        std::cerr << "Error: [OUTPUT PATH] must be a path to output image file" << std::endl;
+        return 3;
+    }
+
+    // Device definitions, profiling gives per-command device timestamps
+    auto q = sycl::queue{ vn::priority_backend_selector_v, sycl::property_list{ sycl::property::queue::enable_profiling() } };
+    auto is_usm_compatible = q.get_device().has(sycl::aspect::usm_device_allocations);
+    auto device_name = q.get_device().get_info<sycl::info::device::name>();
+
+    // Display device information
+    std::cout << "Device: " << device_name << std::endl
+              << "Platform: " << q.get_device().get_platform().get_info<sycl::info::platform::name>() << std::endl
+              << "Compute Units: " << q.get_device().get_info<sycl::info::device::max_compute_units>() << std::endl
+              << "Memory Model: " << (is_usm_compatible ? "Unified Shared Memory" : "Generic Buffer") << std::endl
+              << std::endl;
+
+    // Build every kernel before the first launch unless cold start latency is wanted
+    std::optional<vn::KernelBuild> kernels;
+    if (!cold) {
+        try {
+            kernels = vn::build_kernels(q);
+            std::cout << "Kernel Bundle: " << kernels->kernels << " kernels built in " << kernels->milliseconds << "ms" << std::endl
+                      << std::endl;
+        } catch (sycl::exception const& ex) {
+            std::cerr << "Warning: could not build kernels ahead of first use: " << ex.what() << std::endl;
+        }
+    }
+
+    // Load image from provided path
+    vn::Image input;
+    try {
+        input = vn::load_image(inpath.generic_string().c_str());
+        if (!input.is_contiguous())
+            input = input.clone();
+    } catch (std::runtime_error const& ex) {
+        std::cerr << "Error: could not load [INPUT IMAGE]: " << ex.what() << std::endl;
+        return 2;
+    }
+
+    // Display Image information
+    std::cout << "Image Dimensions: " << input.shape[1] << 'x' << input.shape[0] << std::endl
+              << "Image Channels: " << input.channels << std::endl
+              << "Image Pixel Type: " << vn::pixel_type_name(input.type) << std::endl
+              << "Image Length: " << input.length << " bytes" << std::endl
+              << std::endl;
+
+    // Host threads for decoding and encoding, 0 uses one per hardware thread
+    auto io = vn::IoStage(io_threads);
+    auto settings = Settings{ inpath, outpath, inpath.filename().generic_string(), rounds, warmup, depth, budget, true, true, kernels ? "prebuilt" : "cold", &io };
+    std::vector<Record> records;
+
+    // Dispatch on the channel count so every kernel is specialised for it
+    auto run = [&](vn::Image& image, const Settings& settings) {
+        auto status = benchmark_io(image, settings, records);
+        std::cout << std::endl;
+        vn::with_channels(image.channels, [&](auto c) {
+            if (is_usm_compatible) {
+                status = benchmark<decltype(c)::value>(q, image, settings, records);
+                std::cout << std::endl;
+            }
+            if (status == 0)
+                status = benchmark_buffer<decltype(c)::value>(q, image, settings, records);
+            if (status == 0 && is_usm_compatible) {
+                std::cout << std::endl;
+                status = benchmark_split<decltype(c)::value>(image, settings, records);
+            }
+            if (status == 0 && is_usm_compatible) {
+                std::cout << std::endl;
+                status = benchmark_stream<decltype(c)::value>(q, image, settings, records);
+            }
+        });
+        return status;
+    };
+
+    // The 8-bit suites only take 8-bit inputs, deeper ones go through the
+    // pixel type benchmarks alone
+    auto is_8_bit = input.type == vn::PixelType::uint8;
+
+    int status = 0;
+    try {
+        if (is_8_bit)
+            status = run(input, settings);
+
+        // Same kernels instantiated for 16-bit and float elements
+        if (status == 0 && is_usm_compatible) {
+            vn::with_channels(input.channels, [&](auto c) {
+                std::cout << std::endl;
+                status = benchmark_depth<decltype(c)::value, uint16_t>(q, input, settings, records);
+                if (status == 0) {
+                    std::cout << std::endl;
+                    status = benchmark_depth<decltype(c)::value, float>(q, input, settings, records);
+                }
+            });
+        }
+
+        // Per-frame submission overhead of a recorded pipeline against step by step submission
+        if (status == 0 && is_usm_compatible) {
+            std::cout << std::endl;
+            vn::with_channels(input.channels, [&](auto c) {
+                status = benchmark_pipeline<decltype(c)::value>(q, settings, records);
+            });
+        }
+
+        // Host backend against the device on small to medium frames
+        if (status == 0 && is_usm_compatible && is_8_bit) {
+            std::cout << std::endl;
+            vn::with_channels(input.channels, [&](auto c) {
+                status = benchmark_dispatch<decltype(c)::value>(q, input);
+            });
+        }
+
+        // Synthetic square images of doubling size, same channel count as the input
+        for (int side = sweep_min; status == 0 && side <= static_cast<int>(sweep_max); side *= 2) {
+            auto image = synthetic_image(side, side, input.channels);
+            auto sweep_settings = settings;
+            sweep_settings.label = "synthetic-" + std::to_string(side) + "x" + std::to_string(side);
+            sweep_settings.save = false;
+            sweep_settings.batch = false;
+
+            std::cout << std::endl
+                      << "Sweep Image Dimensions: " << side << 'x' << side << std::endl
+                      << std::endl;
+            status = run(image, sweep_settings);
+        }
+
+        // Saved outputs are still being encoded in the background
+        if (settings.io->flush() > 0) {
+            std::cerr << "Error: some output images could not be written" << std::endl;
+            status = 6;
+        }
+
+        // Whole-file pipeline with parallel decode and asynchronous encode around the device
+        if (status == 0 && is_usm_compatible && is_8_bit) {
+            auto filepaths = frames_path.empty() ? std::vector<std::string>(default_stage_frames, inpath.generic_string())
+                                                 : vn::IoStage::list_directory(frames_path.generic_string().c_str());
+            std::cout << std::endl;
+            status = benchmark_stage(q, filepaths, settings);
+        }
+    } catch (std::invalid_argument const& ex) {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        return 5;
+    } catch (std::runtime_error const& ex) {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        return 6;
+    }
+
+    // Machine-readable results for regression tracking
+    if (!csv_path.empty() && !write_csv(csv_path, records)) {
+        std::cerr << "Error: could not write " << csv_path << std::endl;
+        return 6;
+    }
+    if (!json_path.empty() && !write_json(json_path, device_name, records)) {
+        std::cerr << "Error: could not write " << json_path << std::endl;
+        return 6;
+    }
+
+    return status;
+}
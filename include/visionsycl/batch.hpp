@@ -0,0 +1,115 @@
+#ifndef VISIONSYCL_BATCH_HPP
+#define VISIONSYCL_BATCH_HPP
+
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+#include <visionsycl/image.hpp>
+#include <visionsycl/memory.hpp>
+#include <sycl/sycl.hpp>
+
+namespace visionsycl {
+
+// Keeps up to `depth` frames in flight on an out-of-order queue. Every frame
+// is chained upload -> compute -> download through events; the host only
+// blocks when a device slot has to be reused, so the upload of frame k + 1,
+// the compute of frame k and the download of frame k - 1 overlap. Pinned
+// host images are needed for the copies to run asynchronously.
+
+struct BatchStats {
+    size_t frames;
+    int depth;
+    double seconds;
+    double frames_per_second;
+    double steady_frames_per_second;
+};
+
+class BatchProcessor {
+public:
+    BatchProcessor(sycl::queue& q, size_t input_length, size_t output_length, int depth, MemoryPool* pool = nullptr)
+        : q(q), pool(pool), input_length(input_length), output_length(output_length), depth(depth) {
+        if (depth < 1)
+            throw std::invalid_argument("batch depth must be at least 1");
+
+        for (int i = 0; i < depth; ++i) {
+            inputs.push_back(device_allocate<unsigned char>(q, pool, input_length));
+            outputs.push_back(device_allocate<unsigned char>(q, pool, output_length));
+        }
+    }
+
+    BatchProcessor(const BatchProcessor&) = delete;
+    BatchProcessor& operator=(const BatchProcessor&) = delete;
+
+    // Uploads and downloads may still be in flight when process() threw
+    ~BatchProcessor() {
+        q.wait();
+        for (int i = 0; i < depth; ++i) {
+            device_free(q, pool, inputs[i]);
+            device_free(q, pool, outputs[i]);
+        }
+    }
+
+    // launch(in, out, deps) submits the processing of one frame and returns its event
+    template <typename F>
+    BatchStats process(const std::vector<Image>& frames, std::vector<Image>& results, F&& launch) {
+        namespace ch = std::chrono;
+
+        if (frames.size() != results.size())
+            throw std::invalid_argument("batch needs one output image per input image");
+        for (size_t k = 0; k < frames.size(); ++k)
+            if (frames[k].length != input_length || results[k].length != output_length)
+                throw std::invalid_argument("batch images must match the processor frame size");
+
+        auto count = frames.size();
+        std::vector<sycl::event> downloads(count);
+        std::vector<ch::high_resolution_clock::time_point> completions(count);
+        size_t completed = 0;
+
+        auto start = ch::high_resolution_clock::now();
+        for (size_t k = 0; k < count; ++k) {
+            if (k >= static_cast<size_t>(depth)) {
+                downloads[completed].wait_and_throw();
+                completions[completed++] = ch::high_resolution_clock::now();
+            }
+
+            auto slot = k % depth;
+            auto upload = q.memcpy(inputs[slot], frames[k].data, input_length);
+            auto compute = launch(inputs[slot], outputs[slot], std::vector<sycl::event>{ upload });
+            downloads[k] = q.memcpy(results[k].data, outputs[slot], output_length, compute);
+        }
+        for (; completed < count; ++completed) {
+            downloads[completed].wait_and_throw();
+            completions[completed] = ch::high_resolution_clock::now();
+        }
+
+        BatchStats stats{ count, depth, 0.0, 0.0, 0.0 };
+        if (count == 0)
+            return stats;
+
+        stats.seconds = ch::duration<double>(completions.back() - start).count();
+        stats.frames_per_second = count / stats.seconds;
+        if (count > 1) {
+            auto steady = ch::duration<double>(completions.back() - completions.front()).count();
+            stats.steady_frames_per_second = (count - 1) / steady;
+        }
+        else {
+            stats.steady_frames_per_second = stats.frames_per_second;
+        }
+
+        return stats;
+    }
+
+private:
+    sycl::queue& q;
+    MemoryPool* pool;
+    size_t input_length;
+    size_t output_length;
+    int depth;
+    std::vector<unsigned char*> inputs;
+    std::vector<unsigned char*> outputs;
+};
+
+}  // namespace visionsycl
+
+#endif  // VISIONSYCL_BATCH_HPP
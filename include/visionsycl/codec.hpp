@@ -0,0 +1,53 @@
+#ifndef VISIONSYCL_CODEC_HPP
+#define VISIONSYCL_CODEC_HPP
+
+#include <memory>
+#include <string>
+
+#include <visionsycl/image.hpp>
+
+namespace visionsycl {
+
+// Image file codecs behind one interface, picked by file extension, so no
+// caller depends on the library doing the work. Codecs are shared between
+// threads and must be safe to call concurrently.
+class Codec {
+public:
+    virtual ~Codec() = default;
+
+    // Throws std::runtime_error when the file cannot be decoded
+    virtual Image decode(const char* filepath) const = 0;
+    // Returns nonzero on success
+    virtual int encode(const char* filepath, const Image& image) const = 0;
+};
+
+// PNG, JPEG, BMP, TGA, HDR and friends through stb_image; encodes 8-bit
+// images by extension, falling back to PNG, and float images to .hdr
+class StbCodec : public Codec {
+public:
+    Image decode(const char* filepath) const override;
+    int encode(const char* filepath, const Image& image) const override;
+};
+
+// Memory-mapped P5/P6/P7, handing ASCII files to stb_image
+class PnmCodec : public Codec {
+public:
+    Image decode(const char* filepath) const override;
+    int encode(const char* filepath, const Image& image) const override;
+};
+
+class RawCodec : public Codec {
+public:
+    Image decode(const char* filepath) const override;
+    int encode(const char* filepath, const Image& image) const override;
+};
+
+// extension includes the dot and is matched case-insensitively. Unknown
+// extensions get the stb_image codec from codec_for, has_codec tells them apart.
+std::shared_ptr<const Codec> codec_for(const char* filepath);
+bool has_codec(const char* filepath);
+void register_codec(const std::string& extension, std::shared_ptr<const Codec> codec);
+
+}  // namespace visionsycl
+
+#endif  // VISIONSYCL_CODEC_HPP
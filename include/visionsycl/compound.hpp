@@ -0,0 +1,224 @@
+#ifndef VISIONSYCL_COMPOUND_HPP
+#define VISIONSYCL_COMPOUND_HPP
+
+#include <vector>
+
+#include <visionsycl/memory.hpp>
+#include <visionsycl/morphology.hpp>
+#include <visionsycl/pixel.hpp>
+#include <visionsycl/tiled.hpp>
+#include <sycl/sycl.hpp>
+
+namespace visionsycl {
+
+// Compound morphology in one kernel. Each work-group stages its tile with a
+// halo of twice the mask radius, runs the first operation over the tile
+// plus one radius into a second local array, and the second operation from
+// there, so the intermediate image never reaches global memory. Pixels are
+// ranked like ErodeKernel/DilateKernel and pixels outside the image are
+// skipped at both stages, so results match the two kernels run back to
+// back. Differences are taken per color channel and saturate at zero.
+
+enum class MorphologyOperation {
+    opening,    // dilate(erode(in))
+    closing,    // erode(dilate(in))
+    gradient,   // dilate(in) - erode(in)
+    top_hat,    // in - opening
+    black_hat   // closing - in
+};
+
+template <MorphologyOperation operation>
+constexpr bool is_two_stage = operation != MorphologyOperation::gradient;
+
+// Stage one erodes for opening and top-hat, dilates for closing and
+// black-hat; gradient does both in a single stage
+template <MorphologyOperation operation>
+constexpr bool erodes_first = operation == MorphologyOperation::opening || operation == MorphologyOperation::top_hat;
+
+template <int channels, typename inT, typename outT, typename maskT, typename T, MorphologyOperation operation>
+class TiledCompoundMorphologyKernel {
+public:
+    using pixel = sycl::vec<scalar_of<inT>, channels>;
+    static constexpr int halo_scale = is_two_stage<operation> ? 2 : 1;
+
+    TiledCompoundMorphologyKernel(sycl::handler& h, sycl::range<2> tile, inT& in, outT& out, maskT& mask, int mask_width, int mask_height, int width, int height, T min, T max)
+        : in(in), out(out), mask(mask), midy(mask_height / 2), midx(mask_width / 2), width(width), height(height), min(min), max(max),
+          source((tile[0] + 2 * halo_scale * midy) * (tile[1] + 2 * halo_scale * midx), h),
+          stage((is_two_stage<operation> ? tile[0] + 2 * midy : 1) * (is_two_stage<operation> ? tile[1] + 2 * midx : 1), h) {};
+
+    void operator()(sycl::nd_item<2> item) const {
+        auto tile_width = static_cast<int>(item.get_local_range(1));
+        auto tile_height = static_cast<int>(item.get_local_range(0));
+        auto groupx = static_cast<int>(item.get_group(1)) * tile_width;
+        auto groupy = static_cast<int>(item.get_group(0)) * tile_height;
+        auto halox = halo_scale * midx;
+        auto haloy = halo_scale * midy;
+        auto source_width = tile_width + 2 * halox;
+        load_tile<channels>(item, in, source, width, height, halox, haloy, 0);
+
+        auto col = static_cast<int>(item.get_global_id(1));
+        auto row = static_cast<int>(item.get_global_id(0));
+        auto lcol = static_cast<int>(item.get_local_id(1));
+        auto lrow = static_cast<int>(item.get_local_id(0));
+        pixel result;
+
+        if constexpr (is_two_stage<operation>) {
+            // First stage over the tile plus one mask radius
+            auto stage_width = tile_width + 2 * midx;
+            auto stage_height = tile_height + 2 * midy;
+            auto stride = tile_width * tile_height;
+            for (int k = lrow * tile_width + lcol; k < stage_width * stage_height; k += stride) {
+                auto sx = k % stage_width;
+                auto sy = k / stage_width;
+                if constexpr (erodes_first<operation>)
+                    stage[k] = select<MinimumSum>(source, source_width, sx + midx, sy + midy, groupx - halox, groupy - haloy, max);
+                else
+                    stage[k] = select<MaximumSum>(source, source_width, sx + midx, sy + midy, groupx - halox, groupy - haloy, min);
+            }
+            sycl::group_barrier(item.get_group());
+
+            if (col >= width || row >= height)
+                return;
+
+            if constexpr (erodes_first<operation>)
+                result = select<MaximumSum>(stage, stage_width, lcol + midx, lrow + midy, groupx - midx, groupy - midy, min);
+            else
+                result = select<MinimumSum>(stage, stage_width, lcol + midx, lrow + midy, groupx - midx, groupy - midy, max);
+        }
+        else {
+            if (col >= width || row >= height)
+                return;
+
+            auto dilated = select<MaximumSum>(source, source_width, lcol + halox, lrow + haloy, groupx - halox, groupy - haloy, min);
+            auto eroded = select<MinimumSum>(source, source_width, lcol + halox, lrow + haloy, groupx - halox, groupy - haloy, max);
+            result = difference(dilated, eroded);
+        }
+
+        auto original = source[(lrow + haloy) * source_width + lcol + halox];
+        if constexpr (operation == MorphologyOperation::top_hat)
+            result = difference(original, result);
+        else if constexpr (operation == MorphologyOperation::black_hat)
+            result = difference(result, original);
+
+        auto pos = (row * width + col) * channels;
+        if constexpr (has_alpha<channels>)
+            result[channels - 1] = in[pos + channels - 1];
+        store_pixel<channels>(out, pos, result);
+    }
+
+private:
+    // Best pixel under the mask around local position (x, y) of an array
+    // whose first element sits at image position (originx, originy)
+    template <typename Compare, typename localT>
+    pixel select(const localT& local, int local_width, int x, int y, int originx, int originy, T fill) const {
+        Compare better;
+        auto best = pixel(fill);
+        auto sum = color_sum<channels>(best);
+
+        int counter = 0;
+        for (int i = -midx; i <= midx; ++i) {
+            for (int j = -midy; j <= midy; ++j, ++counter) {
+                auto gx = originx + x + i;
+                auto gy = originy + y + j;
+                if (gx < 0 || gx >= width || gy < 0 || gy >= height || mask[counter] == 0)
+                    continue;
+
+                auto px = local[(y + j) * local_width + x + i];
+                auto new_sum = color_sum<channels>(px);
+                if (better(new_sum, sum)) {
+                    best = px;
+                    sum = new_sum;
+                }
+            }
+        }
+        return best;
+    }
+
+    static pixel difference(const pixel& a, const pixel& b) {
+        pixel px;
+        for (int c = 0; c < color_channels<channels>; ++c)
+            px[c] = a[c] > b[c] ? a[c] - b[c] : 0;
+        return px;
+    }
+
+    inT in;
+    outT out;
+    maskT mask;
+    int midy;
+    int midx;
+    int width;
+    int height;
+    T min;
+    T max;
+    sycl::local_accessor<pixel, 1> source;
+    sycl::local_accessor<pixel, 1> stage;
+};
+
+// Repeated erosion or dilation with the tiled kernels, alternating between
+// out and a scratch image so the last pass lands in out. Passes are chained
+// by events with no host wait in between.
+template <int channels, typename T>
+class IteratedMorphology {
+public:
+    IteratedMorphology(sycl::queue& q, int width, int height, sycl::range<2> tile = { default_tile_size, default_tile_size }, MemoryPool* pool = nullptr)
+        : q(q), pool(pool), width(width), height(height), tile(tile) {
+        tmp = device_allocate<T>(q, pool, static_cast<size_t>(width) * height * channels);
+    }
+
+    IteratedMorphology(const IteratedMorphology&) = delete;
+    IteratedMorphology& operator=(const IteratedMorphology&) = delete;
+
+    // Scratch memory may still be in use by submitted passes
+    ~IteratedMorphology() {
+        q.wait();
+        device_free(q, pool, tmp);
+    }
+
+    template <typename maskT>
+    sycl::event erode(T* in, T* out, maskT mask, int mask_width, int mask_height, T max, int iterations, const std::vector<sycl::event>& deps = {}) {
+        return apply<true>(in, out, mask, mask_width, mask_height, max, iterations, deps);
+    }
+
+    template <typename maskT>
+    sycl::event dilate(T* in, T* out, maskT mask, int mask_width, int mask_height, T min, int iterations, const std::vector<sycl::event>& deps = {}) {
+        return apply<false>(in, out, mask, mask_width, mask_height, min, iterations, deps);
+    }
+
+private:
+    template <bool erosion, typename maskT>
+    sycl::event apply(T* in, T* out, maskT mask, int mask_width, int mask_height, T fill, int iterations, const std::vector<sycl::event>& deps) {
+        if (iterations < 1)
+            return q.memcpy(out, in, static_cast<size_t>(width) * height * channels * sizeof(T), deps);
+
+        auto shape = tiled_range(sycl::range<2>{ static_cast<size_t>(height), static_cast<size_t>(width) }, tile);
+        auto e = deps;
+        auto src = in;
+        for (int k = 1; k <= iterations; ++k) {
+            auto dst = (iterations - k) % 2 == 0 ? out : tmp;
+            e = { q.submit([&](sycl::handler& h) {
+                h.depends_on(e);
+                if constexpr (erosion) {
+                    auto kernel = TiledErodeKernel<channels, T*, T*, maskT, T>(h, tile, src, dst, mask, mask_width, mask_height, width, height, fill);
+                    h.parallel_for(shape, kernel);
+                }
+                else {
+                    auto kernel = TiledDilateKernel<channels, T*, T*, maskT, T>(h, tile, src, dst, mask, mask_width, mask_height, width, height, fill);
+                    h.parallel_for(shape, kernel);
+                }
+            }) };
+            src = dst;
+        }
+        return e.front();
+    }
+
+    sycl::queue& q;
+    MemoryPool* pool;
+    int width;
+    int height;
+    sycl::range<2> tile;
+    T* tmp;
+};
+
+}  // namespace visionsycl
+
+#endif  // VISIONSYCL_COMPOUND_HPP
@@ -0,0 +1,83 @@
+#ifndef VISIONSYCL_DISPATCH_HPP
+#define VISIONSYCL_DISPATCH_HPP
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <visionsycl/timing.hpp>
+
+namespace visionsycl {
+
+enum class Backend {
+    host,
+    device
+};
+
+struct CalibrationSample {
+    size_t pixels;
+    double host_milliseconds;
+    double device_milliseconds;
+};
+
+// Sends each call to the host backend or the device by image size. Below
+// the crossover of an operation the fixed cost of submitting and waiting
+// outweighs the device throughput, so the host is faster. Crossovers are
+// measured per operation with calibrate(), or set directly from an earlier
+// calibration; operations never calibrated always go to the device.
+class Dispatcher {
+public:
+    // Pixels from which the device is used, one past the largest calibrated
+    // size when the host won at every one
+    size_t crossover(const std::string& operation) const;
+    void set_crossover(const std::string& operation, size_t pixels);
+    Backend choose(const std::string& operation, size_t pixels) const;
+
+    template <typename H, typename D>
+    Backend run(const std::string& operation, size_t pixels, H&& host, D&& device) const {
+        auto backend = choose(operation, pixels);
+        if (backend == Backend::host)
+            host();
+        else
+            device();
+        return backend;
+    }
+
+    // host(pixels) and device(pixels) process a frame of that many pixels to
+    // completion, the device including its copies and wait. Both run once
+    // unmeasured per size, then the median of repeats runs is compared.
+    template <typename H, typename D>
+    std::vector<CalibrationSample> calibrate(const std::string& operation, const std::vector<size_t>& sizes, H&& host, D&& device, size_t repeats = 5) {
+        std::vector<CalibrationSample> samples;
+        for (auto pixels : sizes)
+            samples.push_back({ pixels, median_milliseconds(host, pixels, repeats), median_milliseconds(device, pixels, repeats) });
+        set_crossover(operation, crossover_of(samples));
+        return samples;
+    }
+
+    // Smallest size from which the device is faster at every larger
+    // calibrated size, never beyond the largest one
+    static size_t crossover_of(const std::vector<CalibrationSample>& samples);
+
+private:
+    template <typename F>
+    static double median_milliseconds(F& f, size_t pixels, size_t repeats) {
+        namespace ch = std::chrono;
+        f(pixels);
+
+        std::vector<double> samples;
+        for (size_t i = 0; i < repeats; ++i) {
+            auto start = ch::high_resolution_clock::now();
+            f(pixels);
+            samples.push_back(ch::duration<double, std::milli>(ch::high_resolution_clock::now() - start).count());
+        }
+        return summarize(samples).median;
+    }
+
+    std::map<std::string, size_t> crossovers;
+};
+
+}  // namespace visionsycl
+
+#endif  // VISIONSYCL_DISPATCH_HPP
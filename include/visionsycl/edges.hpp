@@ -0,0 +1,272 @@
+#ifndef VISIONSYCL_EDGES_HPP
+#define VISIONSYCL_EDGES_HPP
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include <visionsycl/memory.hpp>
+#include <visionsycl/pixel.hpp>
+#include <visionsycl/planar.hpp>
+#include <visionsycl/tiled.hpp>
+#include <sycl/sycl.hpp>
+
+namespace visionsycl {
+
+// Canny edge detection on the device. One tiled kernel converts the input to
+// luminance, takes the 3x3 Sobel gradient and suppresses non-maxima, all in
+// local memory, and writes one byte of edge state per pixel. Hysteresis then
+// grows strong edges through weak pixels inside each tile until the tile is
+// stable, and is relaunched until no tile changes, so only chains crossing
+// tile borders cost extra passes. The result is a single channel map of 255
+// on edges and 0 elsewhere.
+
+constexpr uint8_t edge_none = 0;
+constexpr uint8_t edge_weak = 128;
+constexpr uint8_t edge_strong = 255;
+
+// Gradient magnitude is |gx| + |gy|, up to 2040 for 8-bit luminance.
+// Luminance is replicated past the image border and magnitude is zero there.
+template <int channels, typename inT, typename outT>
+class CannyGradientKernel {
+public:
+    CannyGradientKernel(sycl::handler& h, sycl::range<2> tile, inT& in, outT& out, int width, int height, int low, int high)
+        : in(in), out(out), width(width), height(height), low(low), high(high),
+          luma((tile[0] + 4) * (tile[1] + 4), h), magnitude((tile[0] + 2) * (tile[1] + 2), h) {};
+
+    void operator()(sycl::nd_item<2> item) const {
+        auto tile_width = static_cast<int>(item.get_local_range(1));
+        auto tile_height = static_cast<int>(item.get_local_range(0));
+        auto groupx = static_cast<int>(item.get_group(1)) * tile_width;
+        auto groupy = static_cast<int>(item.get_group(0)) * tile_height;
+        auto stride = tile_width * tile_height;
+        auto first = static_cast<int>(item.get_local_linear_id());
+
+        // Luminance of the tile with a halo of two, one for the gradient and
+        // one for the neighbours compared in suppression
+        auto luma_width = tile_width + 4;
+        for (int k = first; k < luma_width * (tile_height + 4); k += stride) {
+            auto x = sycl::clamp(groupx - 2 + k % luma_width, 0, width - 1);
+            auto y = sycl::clamp(groupy - 2 + k / luma_width, 0, height - 1);
+            auto px = load_pixel<channels>(in, (y * width + x) * channels);
+            if constexpr (color_channels<channels> == 3)
+                luma[k] = luminance(px[0], px[1], px[2]);
+            else
+                luma[k] = px[0];
+        }
+        sycl::group_barrier(item.get_group());
+
+        auto magnitude_width = tile_width + 2;
+        for (int k = first; k < magnitude_width * (tile_height + 2); k += stride) {
+            auto sx = k % magnitude_width;
+            auto sy = k / magnitude_width;
+            auto x = groupx - 1 + sx;
+            auto y = groupy - 1 + sy;
+            if (x < 0 || x >= width || y < 0 || y >= height) {
+                magnitude[k] = 0;
+                continue;
+            }
+            auto g = sobel(luma_width, sx + 1, sy + 1);
+            magnitude[k] = sycl::abs(g[0]) + sycl::abs(g[1]);
+        }
+        sycl::group_barrier(item.get_group());
+
+        auto col = static_cast<int>(item.get_global_id(1));
+        auto row = static_cast<int>(item.get_global_id(0));
+        if (col >= width || row >= height)
+            return;
+
+        auto lcol = static_cast<int>(item.get_local_id(1)) + 1;
+        auto lrow = static_cast<int>(item.get_local_id(0)) + 1;
+        auto m = magnitude[lrow * magnitude_width + lcol];
+        auto g = sobel(luma_width, lcol + 1, lrow + 1);
+
+        // Neighbours across the edge, the gradient direction rounded to one of
+        // four by tan(22.5) ~ 106 / 256 and tan(67.5) ~ 618 / 256
+        auto ax = sycl::abs(g[0]);
+        auto ay = sycl::abs(g[1]);
+        int dx = 1, dy = 0;
+        if (ay * 256 > ax * 618)
+            dx = 0, dy = 1;
+        else if (ay * 256 > ax * 106)
+            dx = (g[0] > 0) == (g[1] > 0) ? 1 : -1, dy = 1;
+
+        auto before = magnitude[(lrow - dy) * magnitude_width + lcol - dx];
+        auto after = magnitude[(lrow + dy) * magnitude_width + lcol + dx];
+        uint8_t state = edge_none;
+        if (m > before && m >= after)
+            state = m > high ? edge_strong : m > low ? edge_weak : edge_none;
+        out[row * width + col] = state;
+    }
+
+private:
+    sycl::vec<int, 2> sobel(int luma_width, int x, int y) const {
+        auto at = [&](int i, int j) { return static_cast<int>(luma[(y + j) * luma_width + x + i]); };
+        auto gx = at(1, -1) + 2 * at(1, 0) + at(1, 1) - at(-1, -1) - 2 * at(-1, 0) - at(-1, 1);
+        auto gy = at(-1, 1) + 2 * at(0, 1) + at(1, 1) - at(-1, -1) - 2 * at(0, -1) - at(1, -1);
+        return { gx, gy };
+    }
+
+    inT in;
+    outT out;
+    int width;
+    int height;
+    int low;
+    int high;
+    sycl::local_accessor<uint8_t, 1> luma;
+    sycl::local_accessor<int, 1> magnitude;
+};
+
+// Promotes weak pixels 8-connected to a strong one until the tile settles,
+// reading in and writing every pixel to out. Sets changed when anything in
+// the tile was promoted, since that may unlock pixels in the next tile.
+template <typename inT, typename outT, typename flagT>
+class HysteresisKernel {
+public:
+    HysteresisKernel(sycl::handler& h, sycl::range<2> tile, inT& in, outT& out, int width, int height, flagT& changed)
+        : in(in), out(out), width(width), height(height), changed(changed), local(tile_length(tile, 3, 3), h) {};
+
+    void operator()(sycl::nd_item<2> item) const {
+        load_tile<1>(item, in, local, width, height, 1, 1, edge_none);
+
+        auto col = static_cast<int>(item.get_global_id(1));
+        auto row = static_cast<int>(item.get_global_id(0));
+        auto inside = col < width && row < height;
+        auto local_width = static_cast<int>(item.get_local_range(1)) + 2;
+        auto own = (static_cast<int>(item.get_local_id(0)) + 1) * local_width + static_cast<int>(item.get_local_id(1)) + 1;
+
+        // Every work-item stays in the loop. Each pass reads the neighbours,
+        // waits, writes its promotion and waits again, so the next pass sees
+        // every write; any_of_group only decides whether to go on.
+        bool grown = false;
+        while (true) {
+            auto promote = inside && local[own][0] == edge_weak && touches_strong(own, local_width);
+            sycl::group_barrier(item.get_group());
+            if (promote) {
+                local[own][0] = edge_strong;
+                grown = true;
+            }
+            sycl::group_barrier(item.get_group());
+            if (!sycl::any_of_group(item.get_group(), promote))
+                break;
+        }
+
+        if (!inside)
+            return;
+        out[row * width + col] = local[own][0];
+        if (grown) {
+            sycl::atomic_ref<int, sycl::memory_order::relaxed, sycl::memory_scope::device, sycl::access::address_space::global_space> flag(changed[0]);
+            flag.store(1);
+        }
+    }
+
+private:
+    bool touches_strong(int own, int local_width) const {
+        for (int j = -1; j <= 1; ++j)
+            for (int i = -1; i <= 1; ++i)
+                if (local[own + j * local_width + i][0] == edge_strong)
+                    return true;
+        return false;
+    }
+
+    inT in;
+    outT out;
+    int width;
+    int height;
+    flagT changed;
+    sycl::local_accessor<sycl::vec<uint8_t, 1>, 1> local;
+};
+
+// Edges are 255, weak pixels never reached by a strong one are dropped
+template <typename inT, typename outT>
+class EdgeMapKernel {
+public:
+    EdgeMapKernel(inT& in, outT& out)
+        : in(in), out(out) {};
+
+    void operator()(sycl::id<1> idx) const {
+        auto i = idx[0];
+        out[i] = in[i] == edge_strong ? 255 : 0;
+    }
+
+private:
+    inT in;
+    outT out;
+};
+
+// Runs the three stages with two scratch state images. Hysteresis reads its
+// changed flag back after every pass, the only host waits in detect().
+// Luminance and thresholds are on the 8-bit scale, so deeper images are
+// converted with ConvertKernel first.
+template <int channels, typename T>
+class CannyDetector {
+    static_assert(std::is_same_v<T, uint8_t>, "Canny detection takes 8-bit images");
+
+public:
+    CannyDetector(sycl::queue& q, int width, int height, sycl::range<2> tile = { default_tile_size, default_tile_size }, MemoryPool* pool = nullptr)
+        : q(q), pool(pool), width(width), height(height), tile(tile) {
+        for (auto& state : states)
+            state = device_allocate<uint8_t>(q, pool, static_cast<size_t>(width) * height);
+        changed = device_allocate<int>(q, pool, 1);
+    }
+
+    CannyDetector(const CannyDetector&) = delete;
+    CannyDetector& operator=(const CannyDetector&) = delete;
+
+    // The edge map kernel may still be reading the last state image
+    ~CannyDetector() {
+        q.wait();
+        for (auto state : states)
+            device_free(q, pool, state);
+        device_free(q, pool, changed);
+    }
+
+    // Thresholds apply to |gx| + |gy|, strong above high, weak above low.
+    // Returns the events of every kernel launched, the edge map last.
+    std::vector<sycl::event> detect(T* in, uint8_t* edges, int low, int high, const std::vector<sycl::event>& deps = {}) {
+        auto shape = tiled_range(sycl::range<2>{ static_cast<size_t>(height), static_cast<size_t>(width) }, tile);
+        std::vector<sycl::event> kernels{ q.submit([&](sycl::handler& h) {
+            h.depends_on(deps);
+            auto kernel = CannyGradientKernel<channels, T*, uint8_t*>(h, tile, in, states[0], width, height, low, high);
+            h.parallel_for(shape, kernel);
+        }) };
+
+        int grown = 1;
+        size_t current = 0;
+        for (passes = 0; grown != 0; ++passes, current = 1 - current) {
+            auto reset = q.memset(changed, 0, sizeof(int), kernels.back());
+            kernels.push_back(q.submit([&](sycl::handler& h) {
+                h.depends_on(reset);
+                auto kernel = HysteresisKernel<uint8_t*, uint8_t*, int*>(h, tile, states[current], states[1 - current], width, height, changed);
+                h.parallel_for(shape, kernel);
+            }));
+            q.memcpy(&grown, changed, sizeof(int), kernels.back()).wait_and_throw();
+        }
+
+        kernels.push_back(q.submit([&](sycl::handler& h) {
+            h.depends_on(kernels.back());
+            auto kernel = EdgeMapKernel<uint8_t*, uint8_t*>(states[current], edges);
+            h.parallel_for(sycl::range<1>{ static_cast<size_t>(width) * height }, kernel);
+        }));
+        return kernels;
+    }
+
+    // Hysteresis launches of the last detect(), the final one changing nothing
+    int iterations() const {
+        return passes;
+    }
+
+private:
+    sycl::queue& q;
+    MemoryPool* pool;
+    int width;
+    int height;
+    sycl::range<2> tile;
+    uint8_t* states[2];
+    int* changed;
+    int passes = 0;
+};
+
+}  // namespace visionsycl
+
+#endif  // VISIONSYCL_EDGES_HPP
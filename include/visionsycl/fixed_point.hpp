@@ -0,0 +1,130 @@
+#ifndef VISIONSYCL_FIXED_POINT_HPP
+#define VISIONSYCL_FIXED_POINT_HPP
+
+#include <cstdint>
+
+#include <visionsycl/pixel.hpp>
+#include <sycl/sycl.hpp>
+
+namespace visionsycl {
+
+// Integer versions of the blur and convolution kernels for 8-bit images.
+// Weights are the float weights scaled by 2^shift, products accumulate in
+// AccT, and the sum is rounded to nearest and saturated on the way out, so
+// every device produces the same bytes. AccT must hold the largest partial
+// sum: int16_t is enough for 3x3 masks at shift 4, int32_t for any mask.
+
+// Rounds mask * 2^shift to integers and moves the rounding residue onto the
+// largest weight, so a mask summing to 1 sums to exactly 2^shift. Returns
+// false when a weight does not fit in int16_t.
+bool quantize_mask(const float* mask, int length, int shift, int16_t* weights);
+
+template <typename AccT>
+uint8_t descale(AccT acc, int shift) {
+    auto half = shift > 0 ? 1 << (shift - 1) : 0;
+    return static_cast<uint8_t>(sycl::clamp((static_cast<int32_t>(acc) + half) >> shift, 0, 255));
+}
+
+template <int channels, typename inT, typename outT, typename maskT, typename AccT>
+class FixedPointConvolutionKernel {
+public:
+    FixedPointConvolutionKernel(inT& in, outT& out, maskT& mask, int mask_width, int mask_height, int shift, int in_pitch = 0, int out_pitch = 0)
+        : in(in), out(out), mask(mask), midy(mask_height / 2), midx(mask_width / 2), shift(shift), in_pitch(in_pitch), out_pitch(out_pitch) {};
+
+    void operator()(sycl::item<2> item) const {
+        auto col = item.get_id(1);
+        auto row = item.get_id(0);
+        auto width = item.get_range(1);
+        auto height = item.get_range(0);
+        size_t in_stride = in_pitch ? in_pitch : width * channels;
+        size_t out_stride = out_pitch ? out_pitch : width * channels;
+        AccT acc[color_channels<channels>] = {};
+
+        int counter = 0;
+        for (int i = -midx; i <= midx; ++i) {
+            for (int j = -midy; j <= midy; ++j, ++counter) {
+                auto x = col + i;
+                auto y = row + j;
+
+                if (x >= 0 && x < width && y >= 0 && y < height) {
+                    auto px = load_pixel<channels>(in, y * in_stride + x * channels);
+                    for (int c = 0; c < color_channels<channels>; ++c)
+                        acc[c] += static_cast<AccT>(px[c] * mask[counter]);
+                }
+            }
+        }
+
+        sycl::vec<uint8_t, channels> px;
+        for (int c = 0; c < color_channels<channels>; ++c)
+            px[c] = descale(acc[c], shift);
+        if constexpr (has_alpha<channels>)
+            px[channels - 1] = in[row * in_stride + col * channels + channels - 1];
+        store_pixel<channels>(out, row * out_stride + col * channels, px);
+    }
+
+private:
+    inT in;
+    outT out;
+    maskT mask;
+    int midx;
+    int midy;
+    int shift;
+    int in_pitch;
+    int out_pitch;
+};
+
+template <int channels, typename inT, typename outT, typename AccT>
+class FixedPointGaussianBlur3X3Kernel {
+public:
+    FixedPointGaussianBlur3X3Kernel(inT& in, outT& out, int in_pitch = 0, int out_pitch = 0)
+        : in(in), out(out), in_pitch(in_pitch), out_pitch(out_pitch) {};
+
+    void operator()(sycl::item<2> item) const {
+        auto col = item.get_id(1);
+        auto row = item.get_id(0);
+        auto width = item.get_range(1);
+        auto height = item.get_range(0);
+        size_t in_stride = in_pitch ? in_pitch : width * channels;
+        size_t out_stride = out_pitch ? out_pitch : width * channels;
+        AccT acc[color_channels<channels>] = {};
+        // clang-format off
+        constexpr const static int16_t mask[] = {
+            1, 2, 1,
+            2, 4, 2,
+            1, 2, 1
+        };
+        // clang-format on
+        constexpr int shift = 4;
+
+        int counter = 0;
+        for (int i = -1; i <= 1; ++i) {
+            for (int j = -1; j <= 1; ++j, ++counter) {
+                auto x = col + i;
+                auto y = row + j;
+
+                if (x >= 0 && x < width && y >= 0 && y < height) {
+                    auto px = load_pixel<channels>(in, y * in_stride + x * channels);
+                    for (int c = 0; c < color_channels<channels>; ++c)
+                        acc[c] += static_cast<AccT>(px[c] * mask[counter]);
+                }
+            }
+        }
+
+        sycl::vec<uint8_t, channels> px;
+        for (int c = 0; c < color_channels<channels>; ++c)
+            px[c] = descale(acc[c], shift);
+        if constexpr (has_alpha<channels>)
+            px[channels - 1] = in[row * in_stride + col * channels + channels - 1];
+        store_pixel<channels>(out, row * out_stride + col * channels, px);
+    }
+
+private:
+    inT in;
+    outT out;
+    int in_pitch;
+    int out_pitch;
+};
+
+}  // namespace visionsycl
+
+#endif  // VISIONSYCL_FIXED_POINT_HPP
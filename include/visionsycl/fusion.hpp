@@ -0,0 +1,107 @@
+#ifndef VISIONSYCL_FUSION_HPP
+#define VISIONSYCL_FUSION_HPP
+
+#include <visionsycl/pixel.hpp>
+#include <sycl/sycl.hpp>
+
+namespace visionsycl {
+
+// Point operations act on one pixel held in registers, so any chain of them
+// can be fused into a single kernel with one read and one write per pixel.
+// Like the standalone kernels they only touch the color channels, holding
+// each channel as int for integer pixels and as float for float ones.
+
+// PixelT is the element type of the image, which sets the full scale
+template <typename PixelT = uint8_t>
+class InversionOp {
+public:
+    template <typename T, int N>
+    void operator()(sycl::vec<T, N>& px) const {
+        for (int c = 0; c < color_channels<N>; ++c)
+            px[c] = mask - px[c];
+    }
+
+private:
+    static constexpr work_of<PixelT> mask = pixel_max<PixelT>;
+};
+
+class GrayscaleOp {
+public:
+    template <typename T, int N>
+    void operator()(sycl::vec<T, N>& px) const {
+        if constexpr (color_channels<N> == 3) {
+            auto mean = (px[0] + px[1] + px[2]) / 3;
+            px[0] = mean;
+            px[1] = mean;
+            px[2] = mean;
+        }
+    }
+};
+
+template <typename T>
+class ThresholdOp {
+public:
+    ThresholdOp(T control, T top)
+        : control(control), top(top) {};
+
+    template <typename U, int N>
+    void operator()(sycl::vec<U, N>& px) const {
+        for (int c = 0; c < color_channels<N>; ++c)
+            px[c] = px[c] > control ? top : 0;
+    }
+
+private:
+    work_of<T> control;
+    work_of<T> top;
+};
+
+template <typename FirstOp, typename SecondOp>
+class ComposedOp {
+public:
+    ComposedOp(FirstOp first, SecondOp second)
+        : first(first), second(second) {};
+
+    template <typename T, int N>
+    void operator()(sycl::vec<T, N>& px) const {
+        first(px);
+        second(px);
+    }
+
+private:
+    FirstOp first;
+    SecondOp second;
+};
+
+template <typename Op>
+Op fuse(Op op) {
+    return op;
+}
+
+template <typename FirstOp, typename SecondOp, typename... Ops>
+auto fuse(FirstOp first, SecondOp second, Ops... ops) {
+    return fuse(ComposedOp<FirstOp, SecondOp>(first, second), ops...);
+}
+
+template <int channels, typename inT, typename outT, typename Op>
+class FusedPointKernel {
+public:
+    FusedPointKernel(inT& in, outT& out, Op op)
+        : in(in), out(out), op(op) {};
+
+    void operator()(sycl::id<1> idx) const {
+        auto i = idx[0] * channels;
+
+        auto px = load_pixel<channels>(in, i).template convert<work_of<scalar_of<inT>>>();
+        op(px);
+        store_pixel<channels>(out, i, px.template convert<scalar_of<outT>>());
+    }
+
+private:
+    inT in;
+    outT out;
+    Op op;
+};
+
+}  // namespace visionsycl
+
+#endif  // VISIONSYCL_FUSION_HPP
@@ -0,0 +1,129 @@
+#ifndef VISIONSYCL_HISTOGRAM_HPP
+#define VISIONSYCL_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <cstdint>
+
+#include <visionsycl/pixel.hpp>
+#include <sycl/sycl.hpp>
+
+namespace visionsycl {
+
+constexpr int histogram_bins = 256;
+constexpr size_t default_histogram_group_size = 256;
+
+// Work-groups stride over the image, so a few per compute unit is enough
+// and fewer groups means fewer global merges
+inline sycl::nd_range<1> histogram_range(size_t pixels, size_t groups, size_t group_size = default_histogram_group_size) {
+    groups = std::max<size_t>(std::min(groups, (pixels + group_size - 1) / group_size), 1);
+    return { groups * group_size, group_size };
+}
+
+// Counts 8-bit values into bins, which must be zeroed beforehand. With
+// luminance the mean of the color channels is counted, the value
+// GrayscaleKernel produces, into 256 bins; otherwise every color channel
+// gets its own 256 bins, one after the other. Each work-group counts into
+// local bins and merges them into the global ones once at the end.
+template <int channels, bool luminance, typename inT, typename binT>
+class HistogramKernel {
+public:
+    static constexpr int length = luminance ? histogram_bins : histogram_bins * color_channels<channels>;
+
+    HistogramKernel(sycl::handler& h, inT& in, binT& bins, size_t pixels)
+        : in(in), bins(bins), pixels(pixels), local(length, h) {};
+
+    void operator()(sycl::nd_item<1> item) const {
+        auto id = item.get_local_linear_id();
+        auto stride = item.get_local_range(0);
+
+        for (size_t k = id; k < length; k += stride) local[k] = 0;
+        sycl::group_barrier(item.get_group());
+
+        for (size_t i = item.get_global_id(0); i < pixels; i += item.get_global_range(0)) {
+            auto px = load_pixel<channels>(in, i * channels);
+            if constexpr (luminance) {
+                int value = px[0];
+                if constexpr (color_channels<channels> == 3)
+                    value = (px[0] + px[1] + px[2]) / 3;
+                count(value);
+            }
+            else {
+                for (int c = 0; c < color_channels<channels>; ++c)
+                    count(c * histogram_bins + px[c]);
+            }
+        }
+        sycl::group_barrier(item.get_group());
+
+        for (size_t k = id; k < length; k += stride) {
+            if (local[k] == 0)
+                continue;
+            sycl::atomic_ref<uint32_t, sycl::memory_order::relaxed, sycl::memory_scope::device, sycl::access::address_space::global_space> bin(bins[k]);
+            bin.fetch_add(local[k]);
+        }
+    }
+
+private:
+    void count(int bin) const {
+        sycl::atomic_ref<uint32_t, sycl::memory_order::relaxed, sycl::memory_scope::work_group, sycl::access::address_space::local_space> counter(local[bin]);
+        counter.fetch_add(1u);
+    }
+
+    inT in;
+    binT bins;
+    size_t pixels;
+    sycl::local_accessor<uint32_t, 1> local;
+};
+
+// Otsu's method: the threshold t maximising the between-class variance of
+// [0, t] and (t, 255], so that ThresholdKernel sends the upper class to top
+template <typename binT>
+int otsu_threshold(const binT& bins) {
+    uint64_t total = 0, weighted = 0;
+    for (int i = 0; i < histogram_bins; ++i) {
+        total += bins[i];
+        weighted += static_cast<uint64_t>(i) * bins[i];
+    }
+
+    uint64_t background = 0, background_sum = 0;
+    float best = -1.0f;
+    int threshold = 0;
+    for (int t = 0; t < histogram_bins; ++t) {
+        background += bins[t];
+        background_sum += static_cast<uint64_t>(t) * bins[t];
+        if (background == 0)
+            continue;
+        auto foreground = total - background;
+        if (foreground == 0)
+            break;
+
+        auto difference = static_cast<float>(background_sum) / background - static_cast<float>(weighted - background_sum) / foreground;
+        auto variance = static_cast<float>(background) * static_cast<float>(foreground) * difference * difference;
+        if (variance > best) {
+            best = variance;
+            threshold = t;
+        }
+    }
+
+    return threshold;
+}
+
+// Single work-item selection over a 256 bin histogram, writing the
+// threshold for ThresholdKernel to read on the device
+template <typename binT, typename outT>
+class OtsuKernel {
+public:
+    OtsuKernel(binT& bins, outT& threshold)
+        : bins(bins), threshold(threshold) {};
+
+    void operator()() const {
+        threshold[0] = otsu_threshold(bins);
+    }
+
+private:
+    binT bins;
+    outT threshold;
+};
+
+}  // namespace visionsycl
+
+#endif  // VISIONSYCL_HISTOGRAM_HPP
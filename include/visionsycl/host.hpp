@@ -0,0 +1,48 @@
+#ifndef VISIONSYCL_HOST_HPP
+#define VISIONSYCL_HOST_HPP
+
+#include <algorithm>
+#include <execution>
+#include <numeric>
+#include <vector>
+
+namespace visionsycl {
+
+// Host backend for the processing.hpp kernels. The kernels are plain
+// functors, so their apply() runs on host memory unchanged and integer
+// results match the device exactly. Work is split into blocks of rows or
+// pixels that std::execution::par_unseq spreads over the cores, TBB-backed
+// when the standard library has it, leaving each block as a straight loop
+// the compiler can vectorize.
+
+constexpr size_t host_block_pixels = 16384;
+
+template <typename F>
+void host_blocks(size_t count, F&& f) {
+    std::vector<size_t> blocks(count);
+    std::iota(blocks.begin(), blocks.end(), size_t{ 0 });
+    std::for_each(std::execution::par_unseq, blocks.begin(), blocks.end(), f);
+}
+
+// Point kernels over pixels laid out contiguously
+template <int channels, typename Kernel>
+void host_point(const Kernel& kernel, size_t pixels) {
+    host_blocks((pixels + host_block_pixels - 1) / host_block_pixels, [&kernel, pixels](size_t block) {
+        auto end = std::min((block + 1) * host_block_pixels, pixels);
+        for (auto i = block * host_block_pixels; i < end; ++i)
+            kernel.apply(i * channels, i * channels);
+    });
+}
+
+// Stencil kernels over a width x height image, one block per row
+template <typename Kernel>
+void host_stencil(const Kernel& kernel, size_t width, size_t height) {
+    host_blocks(height, [&kernel, width, height](size_t row) {
+        for (size_t col = 0; col < width; ++col)
+            kernel.apply(col, row, width, height);
+    });
+}
+
+}  // namespace visionsycl
+
+#endif  // VISIONSYCL_HOST_HPP
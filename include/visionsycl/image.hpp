@@ -1,25 +1,159 @@
 #ifndef VISIONSYCL_IMAGE_HPP
 #define VISIONSYCL_IMAGE_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+#include <sycl/sycl.hpp>
+
 namespace visionsycl {
 
+// Backing store of an Image. Pinned (sycl::malloc_host) memory lets the
+// runtime DMA straight from the image, shared USM can be read by kernels in
+// place, mapped images read a memory-mapped file in place, and views borrow
+// the memory of another image.
+enum class Storage {
+    pageable,
+    pinned,
+    shared,
+    mapped,
+    view
+};
+
+// Element type of every channel. Values are stored as-is, so 12-bit camera
+// data sits in uint16 unscaled; float images are nominally in [0, 1].
+enum class PixelType : uint32_t {
+    uint8 = 0,
+    uint16 = 1,
+    float32 = 2
+};
+
+template <typename T>
+struct pixel_type_traits;
+
+template <>
+struct pixel_type_traits<uint8_t> {
+    static constexpr PixelType type = PixelType::uint8;
+};
+
+template <>
+struct pixel_type_traits<uint16_t> {
+    static constexpr PixelType type = PixelType::uint16;
+};
+
+template <>
+struct pixel_type_traits<float> {
+    static constexpr PixelType type = PixelType::float32;
+};
+
+template <typename T>
+constexpr PixelType pixel_type_of = pixel_type_traits<T>::type;
+
+inline size_t pixel_size(PixelType type) {
+    switch (type) {
+    case PixelType::uint8:
+        return 1;
+    case PixelType::uint16:
+        return 2;
+    case PixelType::float32:
+        return 4;
+    }
+    throw std::invalid_argument("unsupported pixel type");
+}
+
+inline const char* pixel_type_name(PixelType type) {
+    switch (type) {
+    case PixelType::uint8:
+        return "uint8";
+    case PixelType::uint16:
+        return "uint16";
+    case PixelType::float32:
+        return "float32";
+    }
+    return "unknown";
+}
+
+template <typename T>
+struct pixel_type_tag {
+    using type = T;
+};
+
+// Calls f with the element type as a tag, so kernels are instantiated per
+// type like with_channels does per channel count
+template <typename F>
+void with_pixel_type(PixelType type, F&& f) {
+    switch (type) {
+    case PixelType::uint8:
+        f(pixel_type_tag<uint8_t>{});
+        break;
+    case PixelType::uint16:
+        f(pixel_type_tag<uint16_t>{});
+        break;
+    case PixelType::float32:
+        f(pixel_type_tag<float>{});
+        break;
+    default:
+        throw std::invalid_argument("unsupported pixel type");
+    }
+}
+
+// Move-only owner of interleaved pixel data. shape is { height, width } and
+// step is { bytes per row, bytes per pixel }; rows of a view keep the step of
+// the image they were taken from. length is in bytes and data points at the
+// first byte whatever the pixel type; pixels<T>() reads it as elements.
 class Image {
 public:
     int channels;
     int dimensions;
-    int* shape;
-    int* step;
+    int shape[2];
+    int step[2];
     unsigned long length;
     unsigned char* data;
+    PixelType type;
 
     Image();
-    Image(int width, int height, int channels);
+    Image(int width, int height, int channels, PixelType type = PixelType::uint8);
+    Image(int width, int height, int channels, Storage storage, const sycl::queue& q, PixelType type = PixelType::uint8);
+    Image(int width, int height, int channels, int stride, unsigned char* data, std::shared_ptr<void> owner, PixelType type = PixelType::uint8);
+    Image(Image&& other) noexcept;
+    Image& operator=(Image&& other) noexcept;
+    Image(const Image&) = delete;
+    Image& operator=(const Image&) = delete;
     ~Image();
+
+    Image roi(int x, int y, int width, int height) const;
+    Image clone() const;
+    Image clone(Storage storage, const sycl::queue& q) const;
+    bool is_contiguous() const;
+    Storage storage() const;
+
+    // Throws std::invalid_argument when T is not the pixel type
+    template <typename T>
+    T* pixels() const {
+        if (pixel_type_of<T> != type)
+            throw std::invalid_argument("pixel type mismatch");
+        return reinterpret_cast<T*>(data);
+    }
+
+    friend class StbCodec;
+
+private:
+    void allocate(int width, int height, int channels, PixelType type);
+    void release();
+
+    Storage kind;
+    std::optional<sycl::context> context;
+    std::shared_ptr<void> owner;
 };
 
 Image load_image(const char* filepath);
+Image load_image(const char* filepath, Storage storage, const sycl::queue& q);
 int save_image_as(const char* filepath, Image& image);
 
 }  // namespace visionsycl
 
-#endif  // VISIONSYCL_IMAGE_HPP
\ No newline at end of file
+#endif  // VISIONSYCL_IMAGE_HPP
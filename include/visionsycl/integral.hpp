@@ -0,0 +1,190 @@
+#ifndef VISIONSYCL_INTEGRAL_HPP
+#define VISIONSYCL_INTEGRAL_HPP
+
+#include <cstdint>
+#include <type_traits>
+
+#include <visionsycl/pixel.hpp>
+#include <sycl/sycl.hpp>
+
+namespace visionsycl {
+
+// Summed-area tables hold one uint32_t per color channel for each of the
+// (height + 1) x (width + 1) corners, the first row and column being zero,
+// so any window sum is four reads. Totals past 2^32 wrap, but unsigned
+// differences stay exact for any window smaller than 2^32 / max pixels,
+// max being 255 for uint8 and 65535 for uint16. Float pixels are not
+// supported, the sums being integers.
+
+constexpr size_t default_integral_group_size = 256;
+
+template <int channels>
+size_t integral_length(int width, int height) {
+    return static_cast<size_t>(width + 1) * (height + 1) * color_channels<channels>;
+}
+
+// One work-group per row
+inline sycl::nd_range<1> integral_row_range(int height, size_t group_size = default_integral_group_size) {
+    return { static_cast<size_t>(height) * group_size, group_size };
+}
+
+// One work-item per column and channel of the table
+template <int channels>
+sycl::range<1> integral_column_range(int width) {
+    return { static_cast<size_t>(width + 1) * color_channels<channels> };
+}
+
+// First pass: each work-group scans its row in chunks of the group size,
+// carrying the running total from one chunk to the next
+template <int channels, typename inT, typename sumT>
+class IntegralRowKernel {
+    static_assert(std::is_integral_v<scalar_of<inT>>, "summed-area tables take integer pixels");
+
+public:
+    IntegralRowKernel(inT& in, sumT& sums, int width)
+        : in(in), sums(sums), width(width) {};
+
+    void operator()(sycl::nd_item<1> item) const {
+        constexpr int colors = color_channels<channels>;
+        auto group = item.get_group();
+        auto row = item.get_group(0);
+        auto id = item.get_local_id(0);
+        auto size = item.get_local_range(0);
+        auto line = (row + 1) * (width + 1) * colors;
+        uint32_t carry[colors] = {};
+
+        if (id == 0)
+            for (int c = 0; c < colors; ++c) sums[line + c] = 0;
+
+        for (size_t start = 0; start < static_cast<size_t>(width); start += size) {
+            auto x = start + id;
+            auto inside = x < static_cast<size_t>(width);
+            auto px = inside ? load_pixel<channels>(in, (row * width + x) * channels) : sycl::vec<scalar_of<inT>, channels>(0);
+
+            for (int c = 0; c < colors; ++c) {
+                auto scanned = sycl::inclusive_scan_over_group(group, static_cast<uint32_t>(px[c]), sycl::plus<uint32_t>());
+                if (inside)
+                    sums[line + (x + 1) * colors + c] = carry[c] + scanned;
+                carry[c] += sycl::group_broadcast(group, scanned, size - 1);
+            }
+        }
+    }
+
+private:
+    inT in;
+    sumT sums;
+    int width;
+};
+
+// Second pass: each work-item walks down one column of row sums, so
+// neighbouring work-items touch neighbouring addresses on every row
+template <int channels, typename sumT>
+class IntegralColumnKernel {
+public:
+    IntegralColumnKernel(sumT& sums, int height)
+        : sums(sums), height(height) {};
+
+    void operator()(sycl::item<1> item) const {
+        auto i = item.get_id(0);
+        auto stride = item.get_range(0);
+        uint32_t acc = 0;
+
+        sums[i] = 0;
+        for (int y = 1; y <= height; ++y) {
+            acc += sums[y * stride + i];
+            sums[y * stride + i] = acc;
+        }
+    }
+
+private:
+    sumT sums;
+    int height;
+};
+
+// Sum of channel c over columns [x0, x1) and rows [y0, y1)
+template <int channels, typename sumT>
+uint32_t window_sum(const sumT& sums, int width, int x0, int y0, int x1, int y1, int c) {
+    constexpr int colors = color_channels<channels>;
+    auto stride = static_cast<size_t>(width + 1) * colors;
+    return sums[y1 * stride + x1 * colors + c] - sums[y0 * stride + x1 * colors + c] - sums[y1 * stride + x0 * colors + c] + sums[y0 * stride + x0 * colors + c];
+}
+
+// Mean over the (2 * radius + 1)^2 window clipped to the image, rounded to
+// nearest, at the same cost for any radius
+template <int channels, typename inT, typename sumT, typename outT>
+class BoxFilterKernel {
+    static_assert(std::is_integral_v<scalar_of<outT>>, "box filtering takes integer pixels");
+
+public:
+    BoxFilterKernel(inT& in, sumT& sums, outT& out, int radius)
+        : in(in), sums(sums), out(out), radius(radius) {};
+
+    void operator()(sycl::item<2> item) const {
+        auto col = static_cast<int>(item.get_id(1));
+        auto row = static_cast<int>(item.get_id(0));
+        auto width = static_cast<int>(item.get_range(1));
+        auto height = static_cast<int>(item.get_range(0));
+        auto x0 = sycl::max(col - radius, 0);
+        auto y0 = sycl::max(row - radius, 0);
+        auto x1 = sycl::min(col + radius + 1, width);
+        auto y1 = sycl::min(row + radius + 1, height);
+        auto area = static_cast<uint32_t>((x1 - x0) * (y1 - y0));
+        auto pos = (static_cast<size_t>(row) * width + col) * channels;
+
+        sycl::vec<scalar_of<outT>, channels> px;
+        for (int c = 0; c < color_channels<channels>; ++c)
+            px[c] = static_cast<scalar_of<outT>>((window_sum<channels>(sums, width, x0, y0, x1, y1, c) + area / 2) / area);
+        if constexpr (has_alpha<channels>)
+            px[channels - 1] = in[pos + channels - 1];
+        store_pixel<channels>(out, pos, px);
+    }
+
+private:
+    inT in;
+    sumT sums;
+    outT out;
+    int radius;
+};
+
+// Local mean thresholding: a channel becomes top when it is above the mean
+// of its window minus offset, compared exactly in integers
+template <int channels, typename inT, typename sumT, typename outT, typename T>
+class AdaptiveThresholdKernel {
+    static_assert(std::is_integral_v<scalar_of<inT>>, "adaptive thresholding takes integer pixels");
+
+public:
+    AdaptiveThresholdKernel(inT& in, sumT& sums, outT& out, int radius, int offset, T top)
+        : in(in), sums(sums), out(out), radius(radius), offset(offset), top(top) {};
+
+    void operator()(sycl::item<2> item) const {
+        auto col = static_cast<int>(item.get_id(1));
+        auto row = static_cast<int>(item.get_id(0));
+        auto width = static_cast<int>(item.get_range(1));
+        auto height = static_cast<int>(item.get_range(0));
+        auto x0 = sycl::max(col - radius, 0);
+        auto y0 = sycl::max(row - radius, 0);
+        auto x1 = sycl::min(col + radius + 1, width);
+        auto y1 = sycl::min(row + radius + 1, height);
+        auto area = static_cast<int64_t>(x1 - x0) * (y1 - y0);
+        auto pos = (static_cast<size_t>(row) * width + col) * channels;
+
+        auto px = load_pixel<channels>(in, pos);
+        for (int c = 0; c < color_channels<channels>; ++c) {
+            auto sum = static_cast<int64_t>(window_sum<channels>(sums, width, x0, y0, x1, y1, c));
+            px[c] = (px[c] + offset) * area > sum ? top : 0;
+        }
+        store_pixel<channels>(out, pos, px);
+    }
+
+private:
+    inT in;
+    sumT sums;
+    outT out;
+    int radius;
+    int offset;
+    T top;
+};
+
+}  // namespace visionsycl
+
+#endif  // VISIONSYCL_INTEGRAL_HPP
@@ -0,0 +1,78 @@
+#ifndef VISIONSYCL_IO_HPP
+#define VISIONSYCL_IO_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <visionsycl/image.hpp>
+
+namespace visionsycl {
+
+// Read-only files are mapped copy-on-write, so images loaded from them can be
+// modified in place without touching the file. Files created for writing are
+// mapped shared and land on disk when the mapping is dropped.
+class MappedFile {
+public:
+    explicit MappedFile(const char* filepath);
+    MappedFile(const char* filepath, size_t length);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    unsigned char* data() const;
+    size_t size() const;
+
+private:
+    unsigned char* address;
+    size_t length;
+#ifdef _WIN32
+    void* file;
+    void* mapping;
+#endif
+};
+
+// Headered raw pixels: a fixed header followed, at offset, by height rows of
+// stride bytes. Rows start 64-byte aligned in the file and dtype is the
+// PixelType of every channel. Header and pixels are in host byte order, so
+// files only move between machines of the same endianness.
+struct RawHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t channels;
+    uint32_t stride;
+    PixelType dtype;
+    uint64_t offset;
+};
+
+constexpr char raw_magic[8] = { 'V', 'S', 'Y', 'C', 'L', 'R', 'A', 'W' };
+constexpr uint32_t raw_version = 1;
+constexpr size_t raw_alignment = 64;
+
+// Mapped images keep their file mapping alive and read pixels in place.
+// Raw rows are aligned for vector loads, PNM rows start wherever the text
+// header ends.
+// 16-bit PNM samples are big-endian, so load_pnm copies them into a
+// pageable uint16 image instead of mapping. It returns an empty image for
+// valid PNM files it cannot read, e.g. ASCII ones, so the caller can fall
+// back to a decoder.
+Image load_raw(const char* filepath);
+Image load_pnm(const char* filepath);
+
+// PNM picks the variant from the channel count: P5 (gray), P6 (RGB) or P7
+// (gray + alpha, RGBA), with a maxval of 65535 for uint16 images; float
+// images only go to raw. Both return nonzero on success, like
+// stb_image_write.
+int save_raw(const char* filepath, const Image& image);
+int save_pnm(const char* filepath, const Image& image);
+
+// Raw image file of the given size mapped for writing, for outputs too large
+// to hold in memory. Rows written to the image land in the file, which is
+// complete once the image is released. Throws std::runtime_error on failure.
+Image create_raw(const char* filepath, int width, int height, int channels, PixelType type = PixelType::uint8);
+
+}  // namespace visionsycl
+
+#endif  // VISIONSYCL_IO_HPP
@@ -0,0 +1,114 @@
+#ifndef VISIONSYCL_IO_STAGE_HPP
+#define VISIONSYCL_IO_STAGE_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <visionsycl/image.hpp>
+#include <visionsycl/thread_pool.hpp>
+
+namespace visionsycl {
+
+// Host side of a frame pipeline. Files are decoded and results encoded on a
+// thread pool, so codec work overlaps whatever the calling thread submits
+// to the device in between.
+class IoStage {
+public:
+    // max_pending bounds how many decoded frames wait to be consumed,
+    // 0 means twice the number of threads
+    explicit IoStage(size_t threads = 0, size_t max_pending = 0);
+
+    IoStage(const IoStage&) = delete;
+    IoStage& operator=(const IoStage&) = delete;
+
+    // Decodes every file in parallel and calls consume(index, image) on the
+    // calling thread in completion order. The first decode error is rethrown
+    // once the frames already in flight have been drained.
+    template <typename F>
+    void decode(const std::vector<std::string>& filepaths, F&& consume) {
+        auto state = std::make_shared<Completions>();
+        size_t submitted = 0, consumed = 0;
+        std::exception_ptr error;
+
+        auto submit = [&] {
+            auto index = submitted++;
+            pool.submit([state, index, filepath = filepaths[index]] {
+                Completion done{ index, Image(), nullptr };
+                try {
+                    done.image = load_image(filepath.c_str());
+                } catch (...) {
+                    done.error = std::current_exception();
+                }
+                {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    state->done.push_back(std::move(done));
+                }
+                state->ready.notify_one();
+            });
+        };
+
+        while (submitted < filepaths.size() && submitted < max_pending) submit();
+
+        while (consumed < submitted) {
+            Completion done;
+            {
+                std::unique_lock<std::mutex> lock(state->mutex);
+                state->ready.wait(lock, [&state] { return !state->done.empty(); });
+                done = std::move(state->done.front());
+                state->done.pop_front();
+            }
+            ++consumed;
+
+            if (done.error && !error)
+                error = done.error;
+            if (error)
+                continue;
+
+            if (submitted < filepaths.size())
+                submit();
+            consume(done.index, std::move(done.image));
+        }
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    // Takes the image and writes it in the background
+    void encode(std::string filepath, Image image);
+
+    // Waits for every queued encode and returns how many failed
+    size_t flush();
+
+    size_t threads() const;
+
+    // Regular files with a decodable extension, sorted by name
+    static std::vector<std::string> list_directory(const char* directory);
+
+private:
+    struct Completion {
+        size_t index;
+        Image image;
+        std::exception_ptr error;
+    };
+
+    struct Completions {
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::deque<Completion> done;
+    };
+
+    ThreadPool pool;
+    size_t max_pending;
+    std::vector<std::future<int>> encodes;
+};
+
+}  // namespace visionsycl
+
+#endif  // VISIONSYCL_IO_STAGE_HPP
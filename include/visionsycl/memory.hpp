@@ -0,0 +1,75 @@
+#ifndef VISIONSYCL_MEMORY_HPP
+#define VISIONSYCL_MEMORY_HPP
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <sycl/sycl.hpp>
+
+namespace visionsycl {
+
+// Size-class pool of USM blocks for one queue. Freed blocks are kept per
+// class and handed out again, so frames of varying size stop paying for
+// sycl::malloc_* once the pool is warm. Classes are spaced at a quarter of
+// the enclosing power of two, which bounds the waste per block to 25%.
+
+struct PoolStats {
+    size_t hits;
+    size_t misses;
+    size_t bytes_in_use;
+    size_t bytes_reserved;
+    size_t high_water_mark;
+};
+
+class MemoryPool {
+public:
+    MemoryPool(sycl::queue& q, sycl::usm::alloc kind = sycl::usm::alloc::device);
+    ~MemoryPool();
+
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+
+    void* allocate(size_t bytes);
+    // The block is handed out again by the next allocate of its class, so
+    // the caller must make sure no device work still uses it
+    void deallocate(void* ptr);
+    void release();
+    PoolStats stats() const;
+
+    template <typename T>
+    T* allocate(size_t count) {
+        return static_cast<T*>(allocate(count * sizeof(T)));
+    }
+
+    static size_t size_class(size_t bytes);
+
+private:
+    sycl::queue q;
+    sycl::usm::alloc kind;
+    mutable std::mutex mutex;
+    std::unordered_map<size_t, std::vector<void*>> cached;
+    std::unordered_map<void*, size_t> live;
+    PoolStats counters;
+};
+
+// Scratch allocations of the processing classes go through these, so they
+// come from a pool whenever one is given. Owners wait for their work before
+// device_free, since a pooled block is reused at once.
+template <typename T>
+T* device_allocate(sycl::queue& q, MemoryPool* pool, size_t count) {
+    if (pool)
+        return pool->allocate<T>(count);
+    return sycl::malloc_device<T>(count, q);
+}
+
+inline void device_free(sycl::queue& q, MemoryPool* pool, void* ptr) {
+    if (pool)
+        pool->deallocate(ptr);
+    else
+        sycl::free(ptr, q);
+}
+
+}  // namespace visionsycl
+
+#endif  // VISIONSYCL_MEMORY_HPP
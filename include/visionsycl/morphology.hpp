@@ -0,0 +1,223 @@
+#ifndef VISIONSYCL_MORPHOLOGY_HPP
+#define VISIONSYCL_MORPHOLOGY_HPP
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <visionsycl/memory.hpp>
+#include <visionsycl/pixel.hpp>
+#include <sycl/sycl.hpp>
+
+namespace visionsycl {
+
+// van Herk/Gil-Werman erosion and dilation for rectangular structuring
+// elements. Each axis is split into blocks of the window size; per block a
+// prefix and a suffix selection are computed, and every output is the better
+// of one suffix and one prefix entry, whatever the window size. Pixels are
+// ranked by channel sum with ties going to the earliest, so the result matches
+// ErodeKernel/DilateKernel with a full mask. The column pass runs first to
+// keep that tie order.
+
+// True when every entry of the mask is nonzero and both sides are odd, the
+// masks ErodeKernel/DilateKernel centre on a pixel. Only zero against
+// nonzero matters, entries are not weights.
+bool is_rectangle_mask(const unsigned char* mask, int mask_width, int mask_height);
+
+// Sums are compared in their own type, int for integer pixels and float for
+// float ones, so fractional differences are not truncated away
+class MinimumSum {
+public:
+    template <typename S>
+    bool operator()(S candidate, S current) const { return candidate < current; }
+};
+
+class MaximumSum {
+public:
+    template <typename S>
+    bool operator()(S candidate, S current) const { return candidate > current; }
+};
+
+template <int channels, typename inT, typename blockT, typename Compare, typename T>
+class MorphologyBlockKernel {
+public:
+    MorphologyBlockKernel(inT& in, blockT& prefix, blockT& suffix, int width, int height, int window, bool vertical, T fill)
+        : in(in), prefix(prefix), suffix(suffix), width(width), height(height), window(window), vertical(vertical), fill(fill) {};
+
+    void operator()(sycl::item<2> item) const {
+        auto line = static_cast<int>(item.get_id(0));
+        auto start = static_cast<int>(item.get_id(1)) * window;
+        auto padded = static_cast<int>(item.get_range(1)) * window;
+        auto base = line * padded;
+        Compare better;
+
+        auto best = sycl::vec<T, channels>(fill);
+        auto sum = color_sum<channels>(best);
+        for (int i = 0; i < window; ++i) {
+            auto px = load(line, start + i);
+            auto new_sum = color_sum<channels>(px);
+            if (i == 0 || better(new_sum, sum)) {
+                best = px;
+                sum = new_sum;
+            }
+            store_pixel<channels>(prefix, (base + start + i) * channels, best);
+        }
+
+        for (int i = window - 1; i >= 0; --i) {
+            auto px = load(line, start + i);
+            auto new_sum = color_sum<channels>(px);
+            if (i == window - 1 || !better(sum, new_sum)) {
+                best = px;
+                sum = new_sum;
+            }
+            store_pixel<channels>(suffix, (base + start + i) * channels, best);
+        }
+    }
+
+private:
+    sycl::vec<T, channels> load(int line, int p) const {
+        auto k = p - window / 2;
+        auto length = vertical ? height : width;
+
+        if (k >= 0 && k < length)
+            return load_pixel<channels>(in, (vertical ? k * width + line : line * width + k) * channels);
+        return sycl::vec<T, channels>(fill);
+    }
+
+    inT in;
+    blockT prefix;
+    blockT suffix;
+    int width;
+    int height;
+    int window;
+    bool vertical;
+    T fill;
+};
+
+template <int channels, typename inT, typename blockT, typename outT, typename Compare>
+class MorphologyMergeKernel {
+public:
+    MorphologyMergeKernel(inT& in, blockT& prefix, blockT& suffix, outT& out, int width, int window, int padded, bool vertical)
+        : in(in), prefix(prefix), suffix(suffix), out(out), width(width), window(window), padded(padded), vertical(vertical) {};
+
+    void operator()(sycl::item<2> item) const {
+        auto line = static_cast<int>(item.get_id(0));
+        auto k = static_cast<int>(item.get_id(1));
+        Compare better;
+
+        auto left = load_pixel<channels>(suffix, (line * padded + k) * channels);
+        auto right = load_pixel<channels>(prefix, (line * padded + k + window - 1) * channels);
+        auto best = better(color_sum<channels>(right), color_sum<channels>(left)) ? right : left;
+
+        auto pos = (vertical ? k * width + line : line * width + k) * channels;
+        if constexpr (has_alpha<channels>)
+            best[channels - 1] = in[pos + channels - 1];
+        store_pixel<channels>(out, pos, best);
+    }
+
+private:
+    inT in;
+    blockT prefix;
+    blockT suffix;
+    outT out;
+    int width;
+    int window;
+    int padded;
+    bool vertical;
+};
+
+// Mask sides must be odd like the reference kernels' windows, otherwise the
+// constructor throws std::invalid_argument
+template <int channels, typename T>
+class RectangleMorphology {
+public:
+    RectangleMorphology(sycl::queue& q, int width, int height, int mask_width, int mask_height, MemoryPool* pool = nullptr)
+        : q(q), pool(pool), width(width), height(height), mask_width(mask_width), mask_height(mask_height) {
+        if (mask_width < 1 || mask_height < 1 || mask_width % 2 == 0 || mask_height % 2 == 0)
+            throw std::invalid_argument("rectangle masks must have odd sides");
+
+        auto rows = blocks(height, mask_height) * mask_height * static_cast<size_t>(width);
+        auto cols = blocks(width, mask_width) * mask_width * static_cast<size_t>(height);
+        auto length = std::max(rows, cols) * channels;
+
+        prefix = device_allocate<T>(q, pool, length);
+        suffix = device_allocate<T>(q, pool, length);
+        tmp = device_allocate<T>(q, pool, static_cast<size_t>(width) * height * channels);
+    }
+
+    RectangleMorphology(const RectangleMorphology&) = delete;
+    RectangleMorphology& operator=(const RectangleMorphology&) = delete;
+
+    // Scratch memory may still be in use by submitted passes
+    ~RectangleMorphology() {
+        q.wait();
+        device_free(q, pool, prefix);
+        device_free(q, pool, suffix);
+        device_free(q, pool, tmp);
+    }
+
+    sycl::event erode(T* in, T* out, T max, const std::vector<sycl::event>& deps = {}) {
+        return apply<MinimumSum>(in, out, max, deps);
+    }
+
+    sycl::event dilate(T* in, T* out, T min, const std::vector<sycl::event>& deps = {}) {
+        return apply<MaximumSum>(in, out, min, deps);
+    }
+
+private:
+    static size_t blocks(int length, int window) {
+        return (length + window / 2 * 2 + window - 1) / window;
+    }
+
+    template <typename Compare>
+    sycl::event apply(T* in, T* out, T fill, const std::vector<sycl::event>& deps) {
+        if (mask_width == 1 && mask_height == 1)
+            return q.memcpy(out, in, static_cast<size_t>(width) * height * channels * sizeof(T), deps);
+
+        auto e = deps;
+        auto src = in;
+        if (mask_height > 1) {
+            auto dst = mask_width > 1 ? tmp : out;
+            e = { pass<Compare>(src, dst, mask_height, true, fill, e) };
+            src = dst;
+        }
+        if (mask_width > 1)
+            e = { pass<Compare>(src, out, mask_width, false, fill, e) };
+
+        return e.front();
+    }
+
+    template <typename Compare>
+    sycl::event pass(T* src, T* dst, int window, bool vertical, T fill, const std::vector<sycl::event>& deps) {
+        auto lines = static_cast<size_t>(vertical ? width : height);
+        auto length = static_cast<size_t>(vertical ? height : width);
+        auto count = blocks(length, window);
+        auto padded = static_cast<int>(count * window);
+
+        auto block_event = q.submit([&](sycl::handler& h) {
+            h.depends_on(deps);
+            auto kernel = MorphologyBlockKernel<channels, T*, T*, Compare, T>(src, prefix, suffix, width, height, window, vertical, fill);
+            h.parallel_for(sycl::range<2>{ lines, count }, kernel);
+        });
+
+        return q.submit([&](sycl::handler& h) {
+            h.depends_on(block_event);
+            auto kernel = MorphologyMergeKernel<channels, T*, T*, T*, Compare>(src, prefix, suffix, dst, width, window, padded, vertical);
+            h.parallel_for(sycl::range<2>{ lines, length }, kernel);
+        });
+    }
+
+    sycl::queue& q;
+    MemoryPool* pool;
+    int width;
+    int height;
+    int mask_width;
+    int mask_height;
+    T* prefix;
+    T* suffix;
+    T* tmp;
+};
+
+}  // namespace visionsycl
+
+#endif  // VISIONSYCL_MORPHOLOGY_HPP
@@ -0,0 +1,111 @@
+#ifndef VISIONSYCL_MULTI_DEVICE_HPP
+#define VISIONSYCL_MULTI_DEVICE_HPP
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <visionsycl/image.hpp>
+#include <visionsycl/memory.hpp>
+#include <sycl/sycl.hpp>
+
+namespace visionsycl {
+
+// Every USM device the selector accepts, keeping only the best scoring one
+// of each name so a GPU exposed by several backends is used once. CPUs are
+// replaced by their NUMA domain sub-devices when they can be partitioned.
+std::vector<sycl::device> row_split_devices(int (*selector)(const sycl::device&));
+
+// Sub-devices of one per NUMA domain, or the device itself
+std::vector<sycl::device> numa_sub_devices(const sycl::device& device);
+
+struct Band {
+    int first_row;
+    int rows;
+    double milliseconds;
+};
+
+// Splits an image into horizontal bands, one per device, and processes them
+// concurrently. Each device receives its band plus halo rows above and below
+// so stencils see real neighbours across band edges, and only the interior
+// rows are copied back. Band heights follow the rows per millisecond each
+// device sustained on previous runs, starting from an even split.
+class RowSplitExecutor {
+public:
+    explicit RowSplitExecutor(const std::vector<sycl::device>& devices);
+
+    RowSplitExecutor(const RowSplitExecutor&) = delete;
+    RowSplitExecutor& operator=(const RowSplitExecutor&) = delete;
+
+    // Copies constant data such as masks to every device, index i of the
+    // result lives on device i
+    template <typename T>
+    std::vector<T*> broadcast(const T* data, size_t count) {
+        std::vector<T*> copies;
+        for (size_t i = 0; i < queues.size(); ++i) {
+            copies.push_back(pools[i]->allocate<T>(count));
+            queues[i].memcpy(copies.back(), data, count * sizeof(T)).wait_and_throw();
+        }
+        return copies;
+    }
+
+    // launch(index, q, in, out, rows, deps) submits the work for one band,
+    // laid out as a full width image of rows rows, and returns its event
+    template <typename F>
+    void run(const Image& input, Image& output, int halo, F&& launch) {
+        if (!input.is_contiguous() || !output.is_contiguous())
+            throw std::invalid_argument("row-split images must be contiguous");
+        if (input.shape[0] != output.shape[0] || input.shape[1] != output.shape[1])
+            throw std::invalid_argument("row-split images must have the same dimensions");
+
+        reserve(input.length, output.length);
+        split(input.shape[0]);
+
+        auto height = input.shape[0];
+        auto in_pitch = static_cast<size_t>(input.step[0]);
+        auto out_pitch = static_cast<size_t>(output.step[0]);
+        for (size_t i = 0; i < queues.size(); ++i) {
+            auto& band = bands[i];
+            if (band.rows == 0)
+                continue;
+
+            auto top = std::max(band.first_row - halo, 0);
+            auto bottom = std::min(band.first_row + band.rows + halo, height);
+            uploads[i] = queues[i].memcpy(inputs[i], input.data + top * in_pitch, (bottom - top) * in_pitch);
+            auto compute = launch(i, queues[i], inputs[i], outputs[i], bottom - top, std::vector<sycl::event>{ uploads[i] });
+            downloads[i] = queues[i].memcpy(output.data + band.first_row * out_pitch, outputs[i] + (band.first_row - top) * out_pitch, band.rows * out_pitch, compute);
+        }
+
+        for (size_t i = 0; i < queues.size(); ++i)
+            if (bands[i].rows > 0)
+                downloads[i].wait_and_throw();
+        balance();
+    }
+
+    size_t size() const;
+    const std::vector<sycl::queue>& devices() const;
+    const std::vector<Band>& last_bands() const;
+
+private:
+    void reserve(size_t input_length, size_t output_length);
+    void split(int height);
+    void balance();
+
+    std::vector<sycl::queue> queues;
+    std::vector<std::unique_ptr<MemoryPool>> pools;
+    std::vector<bool> profiled;
+    std::vector<double> weights;
+    std::vector<bool> measured;
+    std::vector<Band> bands;
+    std::vector<sycl::event> uploads;
+    std::vector<sycl::event> downloads;
+    std::vector<uint8_t*> inputs;
+    std::vector<uint8_t*> outputs;
+    size_t input_capacity = 0;
+    size_t output_capacity = 0;
+};
+
+}  // namespace visionsycl
+
+#endif  // VISIONSYCL_MULTI_DEVICE_HPP
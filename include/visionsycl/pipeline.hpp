@@ -0,0 +1,150 @@
+#ifndef VISIONSYCL_PIPELINE_HPP
+#define VISIONSYCL_PIPELINE_HPP
+
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <visionsycl/memory.hpp>
+#include <sycl/sycl.hpp>
+
+namespace visionsycl {
+
+// Records a fixed sequence of command groups once and replays it per frame.
+// With sycl_ext_oneapi_graph the sequence becomes a command graph, so a
+// frame costs a single submission however many steps it has. Kernel
+// arguments are baked into a graph when it is finalized, hence every
+// input/output pair gets a graph of its own on first replay; ping-pong and
+// batched frames only ever use a handful of pairs. Without the extension,
+// or on devices that can not run graphs, the steps are submitted to an
+// in-order queue, which still skips the dependency tracking of the
+// out-of-order one.
+//
+// Step k reads what step k - 1 wrote. Intermediate results alternate
+// between out and an owned scratch image so the last step lands in out.
+
+#ifdef SYCL_EXT_ONEAPI_GRAPH
+namespace graph_ext = sycl::ext::oneapi::experimental;
+#endif
+
+class Pipeline {
+public:
+    // step(h, in, out) records one command group into the handler
+    using Step = std::function<void(sycl::handler&, unsigned char*, unsigned char*)>;
+
+    Pipeline(sycl::queue& q, size_t length, MemoryPool* pool = nullptr)
+        : q(q), pool(pool), length(length), ordered(q.get_context(), q.get_device(), ordered_properties(q)) {
+#ifdef SYCL_EXT_ONEAPI_GRAPH
+        graph_support = q.get_device().has(sycl::aspect::ext_oneapi_limited_graph);
+#endif
+    }
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    ~Pipeline() {
+        ordered.wait();
+        if (tmp != nullptr)
+            device_free(q, pool, tmp);
+    }
+
+    void add(Step step) {
+        if (finalized)
+            throw std::logic_error("pipeline steps can not be added after finalize");
+        steps.push_back(std::move(step));
+    }
+
+    void finalize() {
+        if (steps.empty())
+            throw std::logic_error("pipeline needs at least one step");
+        if (steps.size() > 1 && tmp == nullptr)
+            tmp = device_allocate<unsigned char>(q, pool, length);
+        finalized = true;
+    }
+
+    bool uses_graph() const {
+        return graph_support;
+    }
+
+    sycl::event replay(unsigned char* in, unsigned char* out, const std::vector<sycl::event>& deps = {}) {
+        if (!finalized)
+            throw std::logic_error("pipeline must be finalized before replay");
+
+#ifdef SYCL_EXT_ONEAPI_GRAPH
+        if (graph_support) {
+            auto& graph = executable(in, out);
+            return ordered.submit([&](sycl::handler& h) {
+                h.depends_on(deps);
+                h.ext_oneapi_graph(graph);
+            });
+        }
+#endif
+
+        sycl::event e;
+        auto src = in;
+        for (size_t k = 0; k < steps.size(); ++k) {
+            auto dst = destination(k, out);
+            e = ordered.submit([&](sycl::handler& h) {
+                if (k == 0)
+                    h.depends_on(deps);
+                steps[k](h, src, dst);
+            });
+            src = dst;
+        }
+        return e;
+    }
+
+private:
+    static sycl::property_list ordered_properties(const sycl::queue& q) {
+        if (q.has_property<sycl::property::queue::enable_profiling>())
+            return { sycl::property::queue::in_order(), sycl::property::queue::enable_profiling() };
+        return { sycl::property::queue::in_order() };
+    }
+
+    unsigned char* destination(size_t k, unsigned char* out) const {
+        return (steps.size() - 1 - k) % 2 == 0 ? out : tmp;
+    }
+
+#ifdef SYCL_EXT_ONEAPI_GRAPH
+    using ExecutableGraph = graph_ext::command_graph<graph_ext::graph_state::executable>;
+
+    ExecutableGraph& executable(unsigned char* in, unsigned char* out) {
+        auto key = std::make_pair(in, out);
+        auto found = graphs.find(key);
+        if (found != graphs.end())
+            return found->second;
+
+        graph_ext::command_graph<graph_ext::graph_state::modifiable> graph(ordered.get_context(), ordered.get_device());
+        std::vector<graph_ext::node> nodes;
+        auto src = in;
+        for (size_t k = 0; k < steps.size(); ++k) {
+            auto dst = destination(k, out);
+            auto record = [this, k, src, dst](sycl::handler& h) { steps[k](h, src, dst); };
+            if (nodes.empty())
+                nodes.push_back(graph.add(record));
+            else
+                nodes.push_back(graph.add(record, { graph_ext::property::node::depends_on(nodes.back()) }));
+            src = dst;
+        }
+        return graphs.emplace(key, graph.finalize()).first->second;
+    }
+#endif
+
+    sycl::queue& q;
+    MemoryPool* pool;
+    size_t length;
+    sycl::queue ordered;
+    std::vector<Step> steps;
+    unsigned char* tmp = nullptr;
+    bool finalized = false;
+    bool graph_support = false;
+#ifdef SYCL_EXT_ONEAPI_GRAPH
+    std::map<std::pair<unsigned char*, unsigned char*>, ExecutableGraph> graphs;
+#endif
+};
+
+}  // namespace visionsycl
+
+#endif  // VISIONSYCL_PIPELINE_HPP
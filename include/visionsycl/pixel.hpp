@@ -0,0 +1,96 @@
+#ifndef VISIONSYCL_PIXEL_HPP
+#define VISIONSYCL_PIXEL_HPP
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <sycl/sycl.hpp>
+
+namespace visionsycl {
+
+// Interleaved pixels of 1 (gray), 2 (gray + alpha), 3 (RGB) or 4 (RGBA)
+// channels. Kernels only process the color channels; alpha passes through.
+// Two and four channel pixels are moved as one aligned sycl::vec.
+
+template <int channels>
+constexpr bool has_alpha = channels == 2 || channels == 4;
+
+template <int channels>
+constexpr int color_channels = has_alpha<channels> ? channels - 1 : channels;
+
+template <typename ptrT>
+using scalar_of = std::remove_cv_t<std::remove_reference_t<decltype(std::declval<ptrT>()[0])>>;
+
+// Full scale of a channel: 255 for uint8, 65535 for uint16 and 1 for float
+template <typename T>
+constexpr T pixel_max = std::is_floating_point_v<T> ? T(1) : std::numeric_limits<T>::max();
+
+// Arithmetic on channels runs in int for integer pixels, which holds any
+// uint8 or uint16 difference, and in the pixel type for float
+template <typename T>
+using work_of = std::conditional_t<std::is_floating_point_v<T>, T, int>;
+
+template <int channels, typename ptrT>
+sycl::vec<scalar_of<ptrT>, channels> load_pixel(const ptrT& ptr, size_t pos) {
+    using T = scalar_of<ptrT>;
+
+    if constexpr (channels == 2 || channels == 4) {
+        return *reinterpret_cast<const sycl::vec<T, channels>*>(&ptr[pos]);
+    }
+    else {
+        sycl::vec<T, channels> px;
+        for (int c = 0; c < channels; ++c)
+            px[c] = ptr[pos + c];
+        return px;
+    }
+}
+
+template <int channels, typename ptrT>
+void store_pixel(const ptrT& ptr, size_t pos, const sycl::vec<scalar_of<ptrT>, channels>& px) {
+    using T = scalar_of<ptrT>;
+
+    if constexpr (channels == 2 || channels == 4) {
+        *reinterpret_cast<sycl::vec<T, channels>*>(&ptr[pos]) = px;
+    }
+    else {
+        for (int c = 0; c < channels; ++c)
+            ptr[pos + c] = px[c];
+    }
+}
+
+template <typename T>
+using sum_of = decltype(std::declval<T>() + std::declval<T>());
+
+template <int channels, typename T>
+sum_of<T> color_sum(const sycl::vec<T, channels>& px) {
+    sum_of<T> sum = 0;
+    for (int c = 0; c < color_channels<channels>; ++c)
+        sum += px[c];
+    return sum;
+}
+
+template <typename F>
+void with_channels(int channels, F&& f) {
+    switch (channels) {
+    case 1:
+        f(std::integral_constant<int, 1>{});
+        break;
+    case 2:
+        f(std::integral_constant<int, 2>{});
+        break;
+    case 3:
+        f(std::integral_constant<int, 3>{});
+        break;
+    case 4:
+        f(std::integral_constant<int, 4>{});
+        break;
+    default:
+        throw std::invalid_argument("images with " + std::to_string(channels) + " channels are not supported");
+    }
+}
+
+}  // namespace visionsycl
+
+#endif  // VISIONSYCL_PIXEL_HPP
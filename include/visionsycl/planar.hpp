@@ -0,0 +1,109 @@
+#ifndef VISIONSYCL_PLANAR_HPP
+#define VISIONSYCL_PLANAR_HPP
+
+#include <cstdint>
+
+#include <visionsycl/pixel.hpp>
+#include <sycl/sycl.hpp>
+
+namespace visionsycl {
+
+// Planar images keep each channel in a plane of width * height elements,
+// color planes first and alpha last. Every plane is a single channel image
+// of its own, so the channels = 1 kernels process it unchanged with
+// contiguous loads, and point kernels can cover all color planes in one
+// launch of color_channels * width * height elements.
+
+template <typename T>
+T* plane(T* data, int c, size_t plane_length) {
+    return data + c * plane_length;
+}
+
+// Both conversions run one work-item per pixel
+template <int channels, typename inT, typename outT>
+class DeinterleaveKernel {
+public:
+    DeinterleaveKernel(inT& in, outT& out)
+        : in(in), out(out) {};
+
+    void operator()(sycl::item<1> item) const {
+        auto i = item.get_id(0);
+        auto plane_length = item.get_range(0);
+        auto px = load_pixel<channels>(in, i * channels);
+        for (int c = 0; c < channels; ++c)
+            out[c * plane_length + i] = px[c];
+    }
+
+private:
+    inT in;
+    outT out;
+};
+
+template <int channels, typename inT, typename outT>
+class InterleaveKernel {
+public:
+    InterleaveKernel(inT& in, outT& out)
+        : in(in), out(out) {};
+
+    void operator()(sycl::item<1> item) const {
+        auto i = item.get_id(0);
+        auto plane_length = item.get_range(0);
+        sycl::vec<scalar_of<outT>, channels> px;
+        for (int c = 0; c < channels; ++c)
+            px[c] = in[c * plane_length + i];
+        store_pixel<channels>(out, i * channels, px);
+    }
+
+private:
+    inT in;
+    outT out;
+};
+
+// ITU-R BT.601 luma in 8-bit fixed point, the weights summing to 256
+inline uint8_t luminance(int r, int g, int b) {
+    return static_cast<uint8_t>((77 * r + 150 * g + 29 * b + 128) >> 8);
+}
+
+// Weighted grayscale into a single channel output, one byte per pixel.
+// Gray inputs are copied and alpha is dropped.
+template <int channels, typename inT, typename outT>
+class LuminanceKernel {
+public:
+    LuminanceKernel(inT& in, outT& out)
+        : in(in), out(out) {};
+
+    void operator()(sycl::id<1> idx) const {
+        auto i = idx[0];
+        auto px = load_pixel<channels>(in, i * channels);
+        if constexpr (color_channels<channels> == 3)
+            out[i] = luminance(px[0], px[1], px[2]);
+        else
+            out[i] = px[0];
+    }
+
+private:
+    inT in;
+    outT out;
+};
+
+// Same on planar input, three contiguous streams in and one out
+template <typename inT, typename outT>
+class PlanarLuminanceKernel {
+public:
+    PlanarLuminanceKernel(inT& in, outT& out)
+        : in(in), out(out) {};
+
+    void operator()(sycl::item<1> item) const {
+        auto i = item.get_id(0);
+        auto plane_length = item.get_range(0);
+        out[i] = luminance(in[i], in[plane_length + i], in[2 * plane_length + i]);
+    }
+
+private:
+    inT in;
+    outT out;
+};
+
+}  // namespace visionsycl
+
+#endif  // VISIONSYCL_PLANAR_HPP
@@ -1,88 +1,176 @@
 #ifndef VISIONSYCL_PROCESSING_HPP
 #define VISIONSYCL_PROCESSING_HPP
 
+#include <type_traits>
+
 #include <visionsycl/image.hpp>
+#include <visionsycl/pixel.hpp>
 #include <sycl/sycl.hpp>
 
 namespace visionsycl {
 
-template <typename inT, typename outT>
+// inT and outT are anything indexed linearly by element: USM pointers, or
+// one-dimensional accessors when running on buffers. apply() computes one
+// output pixel outside of a SYCL launch, for strided views and the host
+// backend. Elements may be uint8, uint16 or float; the element type is a
+// template parameter, so 8-bit instantiations are unchanged by the others.
+
+// max defaults to the full scale of the pixel type, e.g. pass 4095 for
+// 12-bit data stored in uint16
+template <int channels, typename inT, typename outT>
 class InversionKernel {
 public:
-    InversionKernel(int channels, inT& in, outT& out)
-        : channels(channels), in(in), out(out) {};
+    InversionKernel(inT& in, outT& out, scalar_of<outT> max = pixel_max<scalar_of<outT>>)
+        : in(in), out(out), mask(max) {};
 
     void operator()(sycl::id<1> idx) const {
         auto i = idx[0] * channels;
+        apply(i, i);
+    }
 
-        out[i] = mask - in[i];
-        out[i + 1] = mask - in[i + 1];
-        out[i + 2] = mask - in[i + 2];
+    void apply(size_t i, size_t o) const {
+        auto px = load_pixel<channels>(in, i);
+        for (int c = 0; c < color_channels<channels>; ++c)
+            px[c] = mask - px[c];
+        store_pixel<channels>(out, o, px);
     }
 
 private:
-    int channels;
     inT in;
     outT out;
-    static constexpr uint8_t mask = 255;
+    work_of<scalar_of<outT>> mask;
 };
 
-template <typename inT, typename outT>
+template <int channels, typename inT, typename outT>
 class GrayscaleKernel {
 public:
-    GrayscaleKernel(int channels, inT& in, outT& out)
-        : channels(channels), in(in), out(out) {};
+    GrayscaleKernel(inT& in, outT& out)
+        : in(in), out(out) {};
 
     void operator()(sycl::id<1> idx) const {
         auto i = idx[0] * channels;
+        apply(i, i);
+    }
 
-        auto mean = (in[i] + in[i + 1] + in[i + 2]) / 3;
-        out[i] = mean;
-        out[i + 1] = mean;
-        out[i + 2] = mean;
+    void apply(size_t i, size_t o) const {
+        auto px = load_pixel<channels>(in, i);
+        if constexpr (color_channels<channels> == 3) {
+            auto mean = (px[0] + px[1] + px[2]) / 3;
+            px[0] = mean;
+            px[1] = mean;
+            px[2] = mean;
+        }
+        store_pixel<channels>(out, o, px);
     }
 
 private:
-    int channels;
     inT in;
     outT out;
 };
 
-template <typename inT, typename outT, typename T>
+// control is either a value or a device pointer (or accessor) holding one,
+// so a threshold computed on the device is used without a host round trip
+template <int channels, typename inT, typename outT, typename T, typename controlT = T>
 class ThresholdKernel {
 public:
-    ThresholdKernel(int channels, inT& in, outT& out, T control, T top)
-        : channels(channels), in(in), out(out), control(control), top(top) {};
+    ThresholdKernel(inT& in, outT& out, controlT control, T top)
+        : in(in), out(out), control(control), top(top) {};
 
     void operator()(sycl::id<1> idx) const {
         auto i = idx[0] * channels;
+        apply(i, i);
+    }
 
-        out[i] = in[i] > control ? top : 0;
-        out[i + 1] = in[i + 1] > control ? top : 0;
-        out[i + 2] = in[i + 2] > control ? top : 0;
+    void apply(size_t i, size_t o) const {
+        work_of<scalar_of<inT>> limit;
+        if constexpr (std::is_arithmetic_v<controlT>)
+            limit = control;
+        else
+            limit = control[0];
+
+        auto px = load_pixel<channels>(in, i);
+        for (int c = 0; c < color_channels<channels>; ++c)
+            px[c] = px[c] > limit ? top : 0;
+        store_pixel<channels>(out, o, px);
     }
 
 private:
-    int channels;
-    int control;
-    int top;
+    std::conditional_t<std::is_arithmetic_v<controlT>, work_of<scalar_of<inT>>, controlT> control;
+    work_of<T> top;
     inT in;
     outT out;
 };
 
-template <typename inT, typename outT, typename maskT, typename T>
-class ErodeKernel {
+// Changes the element type, rescaling every channel from the full scale of
+// one type to the other. Integer outputs are rounded and clamped, so float
+// intermediates between filters are quantized once, at the end.
+template <int channels, typename inT, typename outT>
+class ConvertKernel {
 public:
-    ErodeKernel(int channels, inT& in, outT& out, maskT& mask, int mask_width, int mask_height, int max)
-        : channels(channels), in(in), out(out), mask(mask), midy(mask_height / 2), midx(mask_width / 2), max(max) {};
+    using inS = scalar_of<inT>;
+    using outS = scalar_of<outT>;
+
+    ConvertKernel(inT& in, outT& out)
+        : in(in), out(out) {};
+
+    void operator()(sycl::id<1> idx) const {
+        auto i = idx[0] * channels;
+        apply(i, i);
+    }
+
+    void apply(size_t i, size_t o) const {
+        auto px = load_pixel<channels>(in, i);
+        sycl::vec<outS, channels> result;
+        for (int c = 0; c < channels; ++c) {
+            if constexpr (std::is_floating_point_v<outS>)
+                result[c] = static_cast<outS>(px[c] * scale);
+            else
+                result[c] = static_cast<outS>(sycl::clamp(px[c] * scale + 0.5f, 0.0f, static_cast<float>(pixel_max<outS>)));
+        }
+        store_pixel<channels>(out, o, result);
+    }
+
+private:
+    static constexpr float scale = static_cast<float>(pixel_max<outS>) / static_cast<float>(pixel_max<inS>);
+    inT in;
+    outT out;
+};
+
+// Runs a point kernel over a 2D range on images whose rows are in_pitch and
+// out_pitch elements apart, e.g. Image::roi views
+template <int channels, typename Kernel>
+class StridedPointKernel {
+public:
+    StridedPointKernel(Kernel kernel, int in_pitch, int out_pitch)
+        : kernel(kernel), in_pitch(in_pitch), out_pitch(out_pitch) {};
 
     void operator()(sycl::item<2> item) const {
         auto col = item.get_id(1);
         auto row = item.get_id(0);
-        auto width = item.get_range(1);
-        auto height = item.get_range(0);
-        auto r = max, g = max, b = max;
-        float sum = r + g + b;
+        kernel.apply(row * in_pitch + col * channels, row * out_pitch + col * channels);
+    }
+
+private:
+    Kernel kernel;
+    int in_pitch;
+    int out_pitch;
+};
+
+template <int channels, typename inT, typename outT, typename maskT, typename T>
+class ErodeKernel {
+public:
+    ErodeKernel(inT& in, outT& out, maskT& mask, int mask_width, int mask_height, T max, int in_pitch = 0, int out_pitch = 0)
+        : in(in), out(out), mask(mask), midy(mask_height / 2), midx(mask_width / 2), max(max), in_pitch(in_pitch), out_pitch(out_pitch) {};
+
+    void operator()(sycl::item<2> item) const {
+        apply(item.get_id(1), item.get_id(0), item.get_range(1), item.get_range(0));
+    }
+
+    void apply(size_t col, size_t row, size_t width, size_t height) const {
+        size_t in_stride = in_pitch ? in_pitch : width * channels;
+        size_t out_stride = out_pitch ? out_pitch : width * channels;
+        auto best = sycl::vec<scalar_of<inT>, channels>(max);
+        auto sum = color_sum<channels>(best);
 
         int counter = 0;
         for (int i = -midx; i <= midx; ++i) {
@@ -91,47 +179,47 @@ public:
                 auto y = row + j;
 
                 if (x >= 0 && x < width && y >= 0 && y < height) {
-                    auto pos = (y * width + x) * channels;
-                    float new_sum = in[pos] + in[pos + 1] + in[pos + 2];
+                    auto px = load_pixel<channels>(in, y * in_stride + x * channels);
+                    auto new_sum = color_sum<channels>(px);
                     if (mask[counter] != 0 && sum > new_sum) {
-                        r = in[pos];
-                        g = in[pos + 1];
-                        b = in[pos + 2];
+                        best = px;
                         sum = new_sum;
                     }
                 }
             }
         }
 
-        auto pos = (row * width + col) * channels;
-        out[pos] = r;
-        out[pos + 1] = g;
-        out[pos + 2] = b;
+        if constexpr (has_alpha<channels>)
+            best[channels - 1] = in[row * in_stride + col * channels + channels - 1];
+        store_pixel<channels>(out, row * out_stride + col * channels, best);
     }
 
 private:
-    int channels;
     inT in;
     outT out;
     maskT mask;
     int midx;
     int midy;
     T max;
+    int in_pitch;
+    int out_pitch;
 };
 
-template <typename inT, typename outT, typename maskT, typename T>
+template <int channels, typename inT, typename outT, typename maskT, typename T>
 class DilateKernel {
 public:
-    DilateKernel(int channels, inT& in, outT& out, maskT& mask, int mask_width, int mask_height, int min)
-        : channels(channels), in(in), out(out), mask(mask), midy(mask_height / 2), midx(mask_width / 2), min(min) {};
+    DilateKernel(inT& in, outT& out, maskT& mask, int mask_width, int mask_height, T min, int in_pitch = 0, int out_pitch = 0)
+        : in(in), out(out), mask(mask), midy(mask_height / 2), midx(mask_width / 2), min(min), in_pitch(in_pitch), out_pitch(out_pitch) {};
 
     void operator()(sycl::item<2> item) const {
-        auto col = item.get_id(1);
-        auto row = item.get_id(0);
-        auto width = item.get_range(1);
-        auto height = item.get_range(0);
-        auto r = min, g = min, b = min;
-        float sum = r + g + b;
+        apply(item.get_id(1), item.get_id(0), item.get_range(1), item.get_range(0));
+    }
+
+    void apply(size_t col, size_t row, size_t width, size_t height) const {
+        size_t in_stride = in_pitch ? in_pitch : width * channels;
+        size_t out_stride = out_pitch ? out_pitch : width * channels;
+        auto best = sycl::vec<scalar_of<inT>, channels>(min);
+        auto sum = color_sum<channels>(best);
 
         int counter = 0;
         for (int i = -midx; i <= midx; ++i) {
@@ -140,46 +228,46 @@ public:
                 auto y = row + j;
 
                 if (x >= 0 && x < width && y >= 0 && y < height) {
-                    auto pos = (y * width + x) * channels;
-                    float new_sum = in[pos] + in[pos + 1] + in[pos + 2];
+                    auto px = load_pixel<channels>(in, y * in_stride + x * channels);
+                    auto new_sum = color_sum<channels>(px);
                     if (mask[counter] != 0 && sum < new_sum) {
-                        r = in[pos];
-                        g = in[pos + 1];
-                        b = in[pos + 2];
+                        best = px;
                         sum = new_sum;
                     }
                 }
             }
         }
 
-        auto pos = (row * width + col) * channels;
-        out[pos] = r;
-        out[pos + 1] = g;
-        out[pos + 2] = b;
+        if constexpr (has_alpha<channels>)
+            best[channels - 1] = in[row * in_stride + col * channels + channels - 1];
+        store_pixel<channels>(out, row * out_stride + col * channels, best);
     }
 
 private:
-    int channels;
     inT in;
     outT out;
     maskT mask;
     int midx;
     int midy;
     T min;
+    int in_pitch;
+    int out_pitch;
 };
 
-template <typename inT, typename outT, typename maskT, typename MaskScalarT, typename OutScalarT>
+template <int channels, typename inT, typename outT, typename maskT, typename MaskScalarT, typename OutScalarT>
 class ConvolutionKernel {
 public:
-    ConvolutionKernel(int channels, inT& in, outT& out, maskT& mask, int mask_width, int mask_height)
-        : channels(channels), in(in), out(out), mask(mask), midy(mask_height / 2), midx(mask_width / 2) {};
+    ConvolutionKernel(inT& in, outT& out, maskT& mask, int mask_width, int mask_height, int in_pitch = 0, int out_pitch = 0)
+        : in(in), out(out), mask(mask), midy(mask_height / 2), midx(mask_width / 2), in_pitch(in_pitch), out_pitch(out_pitch) {};
 
     void operator()(sycl::item<2> item) const {
-        auto col = item.get_id(1);
-        auto row = item.get_id(0);
-        auto width = item.get_range(1);
-        auto height = item.get_range(0);
-        MaskScalarT r = 0, g = 0, b = 0;
+        apply(item.get_id(1), item.get_id(0), item.get_range(1), item.get_range(0));
+    }
+
+    void apply(size_t col, size_t row, size_t width, size_t height) const {
+        size_t in_stride = in_pitch ? in_pitch : width * channels;
+        size_t out_stride = out_pitch ? out_pitch : width * channels;
+        MaskScalarT acc[color_channels<channels>] = {};
 
         int counter = 0;
         for (int i = -midx; i <= midx; ++i) {
@@ -188,42 +276,45 @@ public:
                 auto y = row + j;
 
                 if (x >= 0 && x < width && y >= 0 && y < height) {
-                    auto pos = (y * width + x) * channels;
-                    r += in[pos] * mask[counter];
-                    g += in[pos + 1] * mask[counter];
-                    b += in[pos + 2] * mask[counter];
+                    auto px = load_pixel<channels>(in, y * in_stride + x * channels);
+                    for (int c = 0; c < color_channels<channels>; ++c)
+                        acc[c] += px[c] * mask[counter];
                 }
             }
         }
 
-        auto pos = (row * width + col) * channels;
-        out[pos] = static_cast<OutScalarT>(r);
-        out[pos + 1] = static_cast<OutScalarT>(g);
-        out[pos + 2] = static_cast<OutScalarT>(b);
+        sycl::vec<OutScalarT, channels> px;
+        for (int c = 0; c < color_channels<channels>; ++c)
+            px[c] = static_cast<OutScalarT>(acc[c]);
+        if constexpr (has_alpha<channels>)
+            px[channels - 1] = in[row * in_stride + col * channels + channels - 1];
+        store_pixel<channels>(out, row * out_stride + col * channels, px);
     }
 
 private:
-    int channels;
     inT in;
     outT out;
     maskT mask;
     int midx;
     int midy;
-    MaskScalarT min;
+    int in_pitch;
+    int out_pitch;
 };
 
-template <typename inT, typename outT, typename OutScalarT>
+template <int channels, typename inT, typename outT, typename OutScalarT>
 class GaussianBlur3X3Kernel {
 public:
-    GaussianBlur3X3Kernel(int channels, inT& in, outT& out)
-        : channels(channels), in(in), out(out) {};
+    GaussianBlur3X3Kernel(inT& in, outT& out, int in_pitch = 0, int out_pitch = 0)
+        : in(in), out(out), in_pitch(in_pitch), out_pitch(out_pitch) {};
 
     void operator()(sycl::item<2> item) const {
-        auto col = item.get_id(1);
-        auto row = item.get_id(0);
-        auto width = item.get_range(1);
-        auto height = item.get_range(0);
-        float r = 0, g = 0, b = 0;
+        apply(item.get_id(1), item.get_id(0), item.get_range(1), item.get_range(0));
+    }
+
+    void apply(size_t col, size_t row, size_t width, size_t height) const {
+        size_t in_stride = in_pitch ? in_pitch : width * channels;
+        size_t out_stride = out_pitch ? out_pitch : width * channels;
+        float acc[color_channels<channels>] = {};
         // clang-format off
         constexpr const static float mask[] = {
             1.0f / 16.0f, 2.0f / 16.0f, 1.0f / 16.0f,
@@ -239,24 +330,26 @@ public:
                 auto y = row + j;
 
                 if (x >= 0 && x < width && y >= 0 && y < height) {
-                    auto pos = (y * width + x) * channels;
-                    r += in[pos] * mask[counter];
-                    g += in[pos + 1] * mask[counter];
-                    b += in[pos + 2] * mask[counter];
+                    auto px = load_pixel<channels>(in, y * in_stride + x * channels);
+                    for (int c = 0; c < color_channels<channels>; ++c)
+                        acc[c] += px[c] * mask[counter];
                 }
             }
         }
 
-        auto pos = (row * width + col) * channels;
-        out[pos] = static_cast<OutScalarT>(r);
-        out[pos + 1] = static_cast<OutScalarT>(g);
-        out[pos + 2] = static_cast<OutScalarT>(b);
+        sycl::vec<OutScalarT, channels> px;
+        for (int c = 0; c < color_channels<channels>; ++c)
+            px[c] = static_cast<OutScalarT>(acc[c]);
+        if constexpr (has_alpha<channels>)
+            px[channels - 1] = in[row * in_stride + col * channels + channels - 1];
+        store_pixel<channels>(out, row * out_stride + col * channels, px);
     }
 
 private:
-    int channels;
     inT in;
     outT out;
+    int in_pitch;
+    int out_pitch;
 };
 
 }  // namespace visionsycl
@@ -0,0 +1,197 @@
+#ifndef VISIONSYCL_RESIZE_HPP
+#define VISIONSYCL_RESIZE_HPP
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include <visionsycl/pixel.hpp>
+#include <sycl/sycl.hpp>
+
+namespace visionsycl {
+
+// Resampling kernels run over the output shape. Every channel is
+// resampled, alpha included, since output pixels have no input pixel of
+// their own to take alpha from.
+
+// Interpolated values round to nearest for integer pixels and are kept as
+// they are for float ones
+template <typename T>
+T round_sample(float value) {
+    if constexpr (std::is_integral_v<T>)
+        return static_cast<T>(value + 0.5f);
+    else
+        return static_cast<T>(value);
+}
+
+// Pixel centres are aligned between the two images, (x + 0.5) * scale - 0.5,
+// and samples past the edge repeat the border pixel
+template <int channels, typename inT, typename outT>
+class BilinearResizeKernel {
+public:
+    BilinearResizeKernel(inT& in, outT& out, int in_width, int in_height)
+        : in(in), out(out), in_width(in_width), in_height(in_height) {};
+
+    void operator()(sycl::item<2> item) const {
+        auto col = item.get_id(1);
+        auto row = item.get_id(0);
+        auto width = item.get_range(1);
+        auto height = item.get_range(0);
+        auto sx = sycl::max((col + 0.5f) * in_width / width - 0.5f, 0.0f);
+        auto sy = sycl::max((row + 0.5f) * in_height / height - 0.5f, 0.0f);
+        auto x0 = sycl::min(static_cast<int>(sx), in_width - 1);
+        auto y0 = sycl::min(static_cast<int>(sy), in_height - 1);
+        auto x1 = sycl::min(x0 + 1, in_width - 1);
+        auto y1 = sycl::min(y0 + 1, in_height - 1);
+        auto fx = sx - x0;
+        auto fy = sy - y0;
+
+        auto p00 = load_pixel<channels>(in, (static_cast<size_t>(y0) * in_width + x0) * channels);
+        auto p01 = load_pixel<channels>(in, (static_cast<size_t>(y0) * in_width + x1) * channels);
+        auto p10 = load_pixel<channels>(in, (static_cast<size_t>(y1) * in_width + x0) * channels);
+        auto p11 = load_pixel<channels>(in, (static_cast<size_t>(y1) * in_width + x1) * channels);
+
+        sycl::vec<scalar_of<outT>, channels> px;
+        for (int c = 0; c < channels; ++c) {
+            auto top = p00[c] + (p01[c] - p00[c]) * fx;
+            auto bottom = p10[c] + (p11[c] - p10[c]) * fx;
+            px[c] = round_sample<scalar_of<outT>>(top + (bottom - top) * fy);
+        }
+        store_pixel<channels>(out, (row * width + col) * channels, px);
+    }
+
+private:
+    inT in;
+    outT out;
+    int in_width;
+    int in_height;
+};
+
+// Each output pixel averages the input area it covers, weighting partially
+// covered pixels by their overlap, which avoids aliasing when shrinking
+template <int channels, typename inT, typename outT>
+class AreaResizeKernel {
+public:
+    AreaResizeKernel(inT& in, outT& out, int in_width, int in_height)
+        : in(in), out(out), in_width(in_width), in_height(in_height) {};
+
+    void operator()(sycl::item<2> item) const {
+        auto col = item.get_id(1);
+        auto row = item.get_id(0);
+        auto width = item.get_range(1);
+        auto height = item.get_range(0);
+        auto scale_x = static_cast<float>(in_width) / width;
+        auto scale_y = static_cast<float>(in_height) / height;
+        auto sx0 = col * scale_x;
+        auto sy0 = row * scale_y;
+        auto sx1 = sycl::min(sx0 + scale_x, static_cast<float>(in_width));
+        auto sy1 = sycl::min(sy0 + scale_y, static_cast<float>(in_height));
+        auto x_end = sycl::min(static_cast<int>(sycl::ceil(sx1)), in_width);
+        auto y_end = sycl::min(static_cast<int>(sycl::ceil(sy1)), in_height);
+        float acc[channels] = {};
+        float area = 0.0f;
+
+        for (auto y = static_cast<int>(sy0); y < y_end; ++y) {
+            auto wy = sycl::min(y + 1.0f, sy1) - sycl::max(static_cast<float>(y), sy0);
+            for (auto x = static_cast<int>(sx0); x < x_end; ++x) {
+                auto weight = wy * (sycl::min(x + 1.0f, sx1) - sycl::max(static_cast<float>(x), sx0));
+                auto px = load_pixel<channels>(in, (static_cast<size_t>(y) * in_width + x) * channels);
+                for (int c = 0; c < channels; ++c)
+                    acc[c] += px[c] * weight;
+                area += weight;
+            }
+        }
+
+        sycl::vec<scalar_of<outT>, channels> px;
+        for (int c = 0; c < channels; ++c)
+            px[c] = round_sample<scalar_of<outT>>(acc[c] / area);
+        store_pixel<channels>(out, (row * width + col) * channels, px);
+    }
+
+private:
+    inT in;
+    outT out;
+    int in_width;
+    int in_height;
+};
+
+// One Gaussian pyramid step: the 3x3 binomial blur of GaussianBlur3X3Kernel
+// evaluated only at even input pixels, so blurring and 2x decimation are a
+// single read of the level above. Borders repeat the edge pixel instead of
+// fading to zero, and integer weights keep every level bit-exact for
+// integer pixels.
+template <int channels, typename inT, typename outT>
+class PyramidDownKernel {
+public:
+    PyramidDownKernel(inT& in, outT& out, int in_width, int in_height)
+        : in(in), out(out), in_width(in_width), in_height(in_height) {};
+
+    void operator()(sycl::item<2> item) const {
+        auto col = static_cast<int>(item.get_id(1));
+        auto row = static_cast<int>(item.get_id(0));
+        auto width = static_cast<int>(item.get_range(1));
+        constexpr int weights[] = { 1, 2, 1 };
+        work_of<scalar_of<outT>> acc[channels] = {};
+
+        for (int j = -1; j <= 1; ++j) {
+            auto y = sycl::clamp(2 * row + j, 0, in_height - 1);
+            for (int i = -1; i <= 1; ++i) {
+                auto x = sycl::clamp(2 * col + i, 0, in_width - 1);
+                auto weight = weights[i + 1] * weights[j + 1];
+                auto px = load_pixel<channels>(in, (static_cast<size_t>(y) * in_width + x) * channels);
+                for (int c = 0; c < channels; ++c)
+                    acc[c] += px[c] * weight;
+            }
+        }
+
+        sycl::vec<scalar_of<outT>, channels> px;
+        for (int c = 0; c < channels; ++c) {
+            if constexpr (std::is_integral_v<scalar_of<outT>>)
+                px[c] = static_cast<scalar_of<outT>>((acc[c] + 8) >> 4);
+            else
+                px[c] = acc[c] / 16;
+        }
+        store_pixel<channels>(out, (static_cast<size_t>(row) * width + col) * channels, px);
+    }
+
+private:
+    inT in;
+    outT out;
+    int in_width;
+    int in_height;
+};
+
+// Level i of a pyramid, offset in elements from the start of its allocation
+struct PyramidLevel {
+    int width;
+    int height;
+    size_t offset;
+};
+
+// Every level in one allocation, level 0 being the full image and each next
+// one half the size rounded up, stopping early once a level is 1x1. Offsets
+// are 64-element aligned so levels start on cache line boundaries.
+std::vector<PyramidLevel> pyramid_layout(int width, int height, int channels, int levels);
+size_t pyramid_length(const std::vector<PyramidLevel>& layout, int channels);
+
+// Fills levels 1 and up from level 0, which the caller has placed at the
+// start of the allocation, with one launch per level whose events are
+// returned in order
+template <int channels, typename T>
+std::vector<sycl::event> build_pyramid(sycl::queue& q, T* pyramid, const std::vector<PyramidLevel>& layout, const std::vector<sycl::event>& deps = {}) {
+    std::vector<sycl::event> events;
+    for (size_t i = 1; i < layout.size(); ++i) {
+        auto& above = layout[i - 1];
+        auto& level = layout[i];
+        auto in = pyramid + above.offset;
+        auto out = pyramid + level.offset;
+        auto kernel = PyramidDownKernel<channels, T*, T*>(in, out, above.width, above.height);
+        auto shape = sycl::range<2>{ static_cast<size_t>(level.height), static_cast<size_t>(level.width) };
+        events.push_back(q.parallel_for(shape, events.empty() ? deps : std::vector<sycl::event>{ events.back() }, kernel));
+    }
+    return events;
+}
+
+}  // namespace visionsycl
+
+#endif  // VISIONSYCL_RESIZE_HPP
@@ -0,0 +1,93 @@
+#ifndef VISIONSYCL_SEPARABLE_HPP
+#define VISIONSYCL_SEPARABLE_HPP
+
+#include <visionsycl/pixel.hpp>
+#include <sycl/sycl.hpp>
+
+namespace visionsycl {
+
+// Masks follow the ConvolutionKernel layout, mask[x * mask_height + y], and
+// are separable when mask[x * mask_height + y] == row[x] * column[y].
+bool separate_mask(const float* mask, int mask_width, int mask_height, float* row, float* column);
+void gaussian_vector(int length, float sigma, float* vector);
+
+template <int channels, typename inT, typename tmpT, typename maskT, typename MaskScalarT>
+class RowConvolutionKernel {
+public:
+    RowConvolutionKernel(inT& in, tmpT& tmp, maskT& row, int mask_width)
+        : in(in), tmp(tmp), row(row), midx(mask_width / 2) {};
+
+    void operator()(sycl::item<2> item) const {
+        auto col = item.get_id(1);
+        auto line = item.get_id(0);
+        auto width = item.get_range(1);
+        MaskScalarT acc[color_channels<channels>] = {};
+
+        int counter = 0;
+        for (int i = -midx; i <= midx; ++i, ++counter) {
+            auto x = col + i;
+
+            if (x >= 0 && x < width) {
+                auto px = load_pixel<channels>(in, (line * width + x) * channels);
+                for (int c = 0; c < color_channels<channels>; ++c)
+                    acc[c] += px[c] * row[counter];
+            }
+        }
+
+        auto pos = (line * width + col) * channels;
+        for (int c = 0; c < color_channels<channels>; ++c)
+            tmp[pos + c] = acc[c];
+        if constexpr (has_alpha<channels>)
+            tmp[pos + channels - 1] = in[pos + channels - 1];
+    }
+
+private:
+    inT in;
+    tmpT tmp;
+    maskT row;
+    int midx;
+};
+
+template <int channels, typename tmpT, typename outT, typename maskT, typename MaskScalarT, typename OutScalarT>
+class ColumnConvolutionKernel {
+public:
+    ColumnConvolutionKernel(tmpT& tmp, outT& out, maskT& column, int mask_height)
+        : tmp(tmp), out(out), column(column), midy(mask_height / 2) {};
+
+    void operator()(sycl::item<2> item) const {
+        auto col = item.get_id(1);
+        auto line = item.get_id(0);
+        auto width = item.get_range(1);
+        auto height = item.get_range(0);
+        MaskScalarT acc[color_channels<channels>] = {};
+
+        int counter = 0;
+        for (int j = -midy; j <= midy; ++j, ++counter) {
+            auto y = line + j;
+
+            if (y >= 0 && y < height) {
+                auto pos = (y * width + col) * channels;
+                for (int c = 0; c < color_channels<channels>; ++c)
+                    acc[c] += tmp[pos + c] * column[counter];
+            }
+        }
+
+        auto pos = (line * width + col) * channels;
+        sycl::vec<OutScalarT, channels> px;
+        for (int c = 0; c < color_channels<channels>; ++c)
+            px[c] = static_cast<OutScalarT>(acc[c]);
+        if constexpr (has_alpha<channels>)
+            px[channels - 1] = static_cast<OutScalarT>(tmp[pos + channels - 1]);
+        store_pixel<channels>(out, pos, px);
+    }
+
+private:
+    tmpT tmp;
+    outT out;
+    maskT column;
+    int midy;
+};
+
+}  // namespace visionsycl
+
+#endif  // VISIONSYCL_SEPARABLE_HPP
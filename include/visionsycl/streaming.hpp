@@ -0,0 +1,110 @@
+#ifndef VISIONSYCL_STREAMING_HPP
+#define VISIONSYCL_STREAMING_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <visionsycl/image.hpp>
+#include <sycl/sycl.hpp>
+
+namespace visionsycl {
+
+struct StreamStats {
+    size_t bands;
+    int band_rows;
+    size_t device_bytes;
+    double seconds;
+};
+
+// Processes images larger than device memory in horizontal bands, each
+// uploaded with halo rows above and below like RowSplitExecutor bands, so
+// device memory never exceeds the budget whatever the image height. Two
+// band slots alternate: while the device computes band k the host stages
+// band k + 1 into pinned memory and queues its upload, and results are
+// written back one band behind. Rows are read and written one at a time, so
+// images mapped with load_raw/load_pnm and create_raw stream from file to
+// file without either being held in memory as a whole.
+class StreamingExecutor {
+public:
+    StreamingExecutor(sycl::queue& q, size_t budget);
+    ~StreamingExecutor();
+
+    StreamingExecutor(const StreamingExecutor&) = delete;
+    StreamingExecutor& operator=(const StreamingExecutor&) = delete;
+
+    // Interior rows of the tallest band that fits the budget, 0 if none does
+    int band_rows(size_t in_row, size_t out_row, int halo) const;
+
+    // launch(q, in, out, rows, deps) submits the work for one band, laid out
+    // as a full width image of rows rows, and returns its event
+    template <typename F>
+    StreamStats run(const Image& input, Image& output, int halo, F&& launch) {
+        namespace ch = std::chrono;
+
+        if (input.shape[0] != output.shape[0] || input.shape[1] != output.shape[1])
+            throw std::invalid_argument("streamed images must have the same dimensions");
+
+        auto height = input.shape[0];
+        auto in_row = static_cast<size_t>(input.shape[1]) * input.step[1];
+        auto out_row = static_cast<size_t>(output.shape[1]) * output.step[1];
+        auto rows = std::min(band_rows(in_row, out_row, halo), height);
+        if (rows < 1)
+            throw std::invalid_argument("memory budget is too small for a single band");
+
+        auto slot_rows = rows + 2 * static_cast<size_t>(halo);
+        reserve(slot_rows * in_row, slot_rows * out_row);
+
+        StreamStats stats{ 0, rows, 2 * (input_capacity + output_capacity), 0.0 };
+        auto start = ch::high_resolution_clock::now();
+        for (int first = 0; first < height; first += rows, ++stats.bands) {
+            auto slot = stats.bands % 2;
+            if (stats.bands >= 2)
+                retire(output, slot, out_row);
+
+            auto band = std::min(rows, height - first);
+            auto top = std::max(first - halo, 0);
+            auto bottom = std::min(first + band + halo, height);
+            stage(input, slot, top, bottom, in_row);
+
+            auto upload = q.memcpy(inputs[slot], staged_inputs[slot], (bottom - top) * in_row);
+            auto compute = launch(q, inputs[slot], outputs[slot], bottom - top, std::vector<sycl::event>{ upload });
+            downloads[slot] = q.memcpy(staged_outputs[slot], outputs[slot] + (first - top) * out_row, band * out_row, compute);
+            pending[slot] = { first, band };
+        }
+
+        // The older of the two bands in flight is written first
+        for (size_t k = stats.bands > 2 ? stats.bands - 2 : 0; k < stats.bands; ++k)
+            retire(output, k % 2, out_row);
+        stats.seconds = ch::duration<double>(ch::high_resolution_clock::now() - start).count();
+
+        return stats;
+    }
+
+private:
+    struct PendingBand {
+        int first_row;
+        int rows;
+    };
+
+    void reserve(size_t input_length, size_t output_length);
+    void stage(const Image& input, size_t slot, int top, int bottom, size_t in_row);
+    void retire(Image& output, size_t slot, size_t out_row);
+
+    sycl::queue q;
+    size_t budget;
+    uint8_t* inputs[2] = {};
+    uint8_t* outputs[2] = {};
+    uint8_t* staged_inputs[2] = {};
+    uint8_t* staged_outputs[2] = {};
+    sycl::event downloads[2];
+    PendingBand pending[2] = {};
+    size_t input_capacity = 0;
+    size_t output_capacity = 0;
+};
+
+}  // namespace visionsycl
+
+#endif  // VISIONSYCL_STREAMING_HPP
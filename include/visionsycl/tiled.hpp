@@ -0,0 +1,253 @@
+#ifndef VISIONSYCL_TILED_HPP
+#define VISIONSYCL_TILED_HPP
+
+#include <visionsycl/pixel.hpp>
+#include <sycl/sycl.hpp>
+
+namespace visionsycl {
+
+// Tiled stencil kernels: every work-group stages its tile plus the mask halo
+// in local memory once, padding pixels outside the image with a value that
+// leaves the result untouched, so the inner loops run without bounds checks.
+// The tile holds whole pixels, one sycl::vec each.
+
+constexpr size_t default_tile_size = 16;
+
+inline sycl::nd_range<2> tiled_range(sycl::range<2> shape, sycl::range<2> tile = { default_tile_size, default_tile_size }) {
+    auto rows = (shape[0] + tile[0] - 1) / tile[0] * tile[0];
+    auto cols = (shape[1] + tile[1] - 1) / tile[1] * tile[1];
+    return { { rows, cols }, tile };
+}
+
+inline size_t tile_length(sycl::range<2> tile, int mask_width, int mask_height) {
+    return (tile[0] + mask_height / 2 * 2) * (tile[1] + mask_width / 2 * 2);
+}
+
+template <int channels, typename inT, typename localT, typename T>
+void load_tile(sycl::nd_item<2> item, const inT& in, const localT& local, int width, int height, int halox, int haloy, T fill) {
+    auto local_width = static_cast<int>(item.get_local_range(1)) + 2 * halox;
+    auto local_height = static_cast<int>(item.get_local_range(0)) + 2 * haloy;
+    auto originx = static_cast<int>(item.get_group(1) * item.get_local_range(1)) - halox;
+    auto originy = static_cast<int>(item.get_group(0) * item.get_local_range(0)) - haloy;
+    auto stride = static_cast<int>(item.get_local_range(0) * item.get_local_range(1));
+
+    for (int k = item.get_local_linear_id(); k < local_width * local_height; k += stride) {
+        auto x = originx + k % local_width;
+        auto y = originy + k / local_width;
+
+        if (x >= 0 && x < width && y >= 0 && y < height)
+            local[k] = load_pixel<channels>(in, (y * width + x) * channels);
+        else
+            local[k] = sycl::vec<scalar_of<inT>, channels>(fill);
+    }
+
+    sycl::group_barrier(item.get_group());
+}
+
+template <int channels, typename inT, typename outT, typename maskT, typename T>
+class TiledErodeKernel {
+public:
+    TiledErodeKernel(sycl::handler& h, sycl::range<2> tile, inT& in, outT& out, maskT& mask, int mask_width, int mask_height, int width, int height, T max)
+        : in(in), out(out), mask(mask), midy(mask_height / 2), midx(mask_width / 2), width(width), height(height), max(max),
+          local(tile_length(tile, mask_width, mask_height), h) {};
+
+    void operator()(sycl::nd_item<2> item) const {
+        load_tile<channels>(item, in, local, width, height, midx, midy, max);
+
+        auto col = static_cast<int>(item.get_global_id(1));
+        auto row = static_cast<int>(item.get_global_id(0));
+        if (col >= width || row >= height)
+            return;
+
+        auto local_width = static_cast<int>(item.get_local_range(1)) + 2 * midx;
+        auto lcol = static_cast<int>(item.get_local_id(1)) + midx;
+        auto lrow = static_cast<int>(item.get_local_id(0)) + midy;
+        auto best = sycl::vec<scalar_of<inT>, channels>(max);
+        auto sum = color_sum<channels>(best);
+
+        int counter = 0;
+        for (int i = -midx; i <= midx; ++i) {
+            for (int j = -midy; j <= midy; ++j, ++counter) {
+                auto px = local[(lrow + j) * local_width + lcol + i];
+                auto new_sum = color_sum<channels>(px);
+                if (mask[counter] != 0 && sum > new_sum) {
+                    best = px;
+                    sum = new_sum;
+                }
+            }
+        }
+
+        auto pos = (row * width + col) * channels;
+        if constexpr (has_alpha<channels>)
+            best[channels - 1] = in[pos + channels - 1];
+        store_pixel<channels>(out, pos, best);
+    }
+
+private:
+    inT in;
+    outT out;
+    maskT mask;
+    int midx;
+    int midy;
+    int width;
+    int height;
+    T max;
+    sycl::local_accessor<sycl::vec<scalar_of<inT>, channels>, 1> local;
+};
+
+template <int channels, typename inT, typename outT, typename maskT, typename T>
+class TiledDilateKernel {
+public:
+    TiledDilateKernel(sycl::handler& h, sycl::range<2> tile, inT& in, outT& out, maskT& mask, int mask_width, int mask_height, int width, int height, T min)
+        : in(in), out(out), mask(mask), midy(mask_height / 2), midx(mask_width / 2), width(width), height(height), min(min),
+          local(tile_length(tile, mask_width, mask_height), h) {};
+
+    void operator()(sycl::nd_item<2> item) const {
+        load_tile<channels>(item, in, local, width, height, midx, midy, min);
+
+        auto col = static_cast<int>(item.get_global_id(1));
+        auto row = static_cast<int>(item.get_global_id(0));
+        if (col >= width || row >= height)
+            return;
+
+        auto local_width = static_cast<int>(item.get_local_range(1)) + 2 * midx;
+        auto lcol = static_cast<int>(item.get_local_id(1)) + midx;
+        auto lrow = static_cast<int>(item.get_local_id(0)) + midy;
+        auto best = sycl::vec<scalar_of<inT>, channels>(min);
+        auto sum = color_sum<channels>(best);
+
+        int counter = 0;
+        for (int i = -midx; i <= midx; ++i) {
+            for (int j = -midy; j <= midy; ++j, ++counter) {
+                auto px = local[(lrow + j) * local_width + lcol + i];
+                auto new_sum = color_sum<channels>(px);
+                if (mask[counter] != 0 && sum < new_sum) {
+                    best = px;
+                    sum = new_sum;
+                }
+            }
+        }
+
+        auto pos = (row * width + col) * channels;
+        if constexpr (has_alpha<channels>)
+            best[channels - 1] = in[pos + channels - 1];
+        store_pixel<channels>(out, pos, best);
+    }
+
+private:
+    inT in;
+    outT out;
+    maskT mask;
+    int midx;
+    int midy;
+    int width;
+    int height;
+    T min;
+    sycl::local_accessor<sycl::vec<scalar_of<inT>, channels>, 1> local;
+};
+
+template <int channels, typename inT, typename outT, typename maskT, typename MaskScalarT, typename OutScalarT>
+class TiledConvolutionKernel {
+public:
+    TiledConvolutionKernel(sycl::handler& h, sycl::range<2> tile, inT& in, outT& out, maskT& mask, int mask_width, int mask_height, int width, int height)
+        : in(in), out(out), mask(mask), midy(mask_height / 2), midx(mask_width / 2), width(width), height(height),
+          local(tile_length(tile, mask_width, mask_height), h) {};
+
+    void operator()(sycl::nd_item<2> item) const {
+        load_tile<channels>(item, in, local, width, height, midx, midy, 0);
+
+        auto col = static_cast<int>(item.get_global_id(1));
+        auto row = static_cast<int>(item.get_global_id(0));
+        if (col >= width || row >= height)
+            return;
+
+        auto local_width = static_cast<int>(item.get_local_range(1)) + 2 * midx;
+        auto lcol = static_cast<int>(item.get_local_id(1)) + midx;
+        auto lrow = static_cast<int>(item.get_local_id(0)) + midy;
+        MaskScalarT acc[color_channels<channels>] = {};
+
+        int counter = 0;
+        for (int i = -midx; i <= midx; ++i) {
+            for (int j = -midy; j <= midy; ++j, ++counter) {
+                auto px = local[(lrow + j) * local_width + lcol + i];
+                for (int c = 0; c < color_channels<channels>; ++c)
+                    acc[c] += px[c] * mask[counter];
+            }
+        }
+
+        auto pos = (row * width + col) * channels;
+        sycl::vec<OutScalarT, channels> px;
+        for (int c = 0; c < color_channels<channels>; ++c)
+            px[c] = static_cast<OutScalarT>(acc[c]);
+        if constexpr (has_alpha<channels>)
+            px[channels - 1] = in[pos + channels - 1];
+        store_pixel<channels>(out, pos, px);
+    }
+
+private:
+    inT in;
+    outT out;
+    maskT mask;
+    int midx;
+    int midy;
+    int width;
+    int height;
+    sycl::local_accessor<sycl::vec<scalar_of<inT>, channels>, 1> local;
+};
+
+template <int channels, typename inT, typename outT, typename OutScalarT>
+class TiledGaussianBlur3X3Kernel {
+public:
+    TiledGaussianBlur3X3Kernel(sycl::handler& h, sycl::range<2> tile, inT& in, outT& out, int width, int height)
+        : in(in), out(out), width(width), height(height),
+          local(tile_length(tile, 3, 3), h) {};
+
+    void operator()(sycl::nd_item<2> item) const {
+        load_tile<channels>(item, in, local, width, height, 1, 1, 0);
+
+        auto col = static_cast<int>(item.get_global_id(1));
+        auto row = static_cast<int>(item.get_global_id(0));
+        if (col >= width || row >= height)
+            return;
+
+        auto local_width = static_cast<int>(item.get_local_range(1)) + 2;
+        auto lcol = static_cast<int>(item.get_local_id(1)) + 1;
+        auto lrow = static_cast<int>(item.get_local_id(0)) + 1;
+        float acc[color_channels<channels>] = {};
+        // clang-format off
+        constexpr const static float mask[] = {
+            1.0f / 16.0f, 2.0f / 16.0f, 1.0f / 16.0f,
+            2.0f / 16.0f, 4.0f / 16.0f, 2.0f / 16.0f,
+            1.0f / 16.0f, 2.0f / 16.0f, 1.0f / 16.0f
+        };
+        // clang-format on
+
+        int counter = 0;
+        for (int i = -1; i <= 1; ++i) {
+            for (int j = -1; j <= 1; ++j, ++counter) {
+                auto px = local[(lrow + j) * local_width + lcol + i];
+                for (int c = 0; c < color_channels<channels>; ++c)
+                    acc[c] += px[c] * mask[counter];
+            }
+        }
+
+        auto pos = (row * width + col) * channels;
+        sycl::vec<OutScalarT, channels> px;
+        for (int c = 0; c < color_channels<channels>; ++c)
+            px[c] = static_cast<OutScalarT>(acc[c]);
+        if constexpr (has_alpha<channels>)
+            px[channels - 1] = in[pos + channels - 1];
+        store_pixel<channels>(out, pos, px);
+    }
+
+private:
+    inT in;
+    outT out;
+    int width;
+    int height;
+    sycl::local_accessor<sycl::vec<scalar_of<inT>, channels>, 1> local;
+};
+
+}  // namespace visionsycl
+
+#endif  // VISIONSYCL_TILED_HPP
@@ -0,0 +1,31 @@
+#ifndef VISIONSYCL_TIMING_HPP
+#define VISIONSYCL_TIMING_HPP
+
+#include <vector>
+
+#include <sycl/sycl.hpp>
+
+namespace visionsycl {
+
+// Latency distribution of repeated runs, in milliseconds. Percentiles use
+// the nearest-rank definition so every value is an observed sample.
+
+struct LatencyStats {
+    size_t samples;
+    double min;
+    double mean;
+    double median;
+    double p95;
+    double p99;
+    double max;
+};
+
+LatencyStats summarize(std::vector<double> samples);
+
+// Sum of command_end - command_start over the events, in milliseconds. The
+// queue must be created with sycl::property::queue::enable_profiling.
+double device_milliseconds(const std::vector<sycl::event>& events);
+
+}  // namespace visionsycl
+
+#endif  // VISIONSYCL_TIMING_HPP
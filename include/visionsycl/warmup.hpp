@@ -0,0 +1,24 @@
+#ifndef VISIONSYCL_WARMUP_HPP
+#define VISIONSYCL_WARMUP_HPP
+
+#include <sycl/sycl.hpp>
+
+namespace visionsycl {
+
+struct KernelBuild {
+    sycl::kernel_bundle<sycl::bundle_state::executable> bundle;
+    size_t kernels;
+    double milliseconds;
+};
+
+// Brings every kernel of the program to executable state for the queue's
+// device up front, so first launches do not stop for JIT compilation.
+// Ahead-of-time images (VISIONSYCL_AOT_CPU) are taken as they are, anything
+// else is built from its input state with sycl::build. Keep the bundle alive
+// for as long as the queue is used; handler::use_kernel_bundle pins it to a
+// submission.
+KernelBuild build_kernels(const sycl::queue& q);
+
+}  // namespace visionsycl
+
+#endif  // VISIONSYCL_WARMUP_HPP
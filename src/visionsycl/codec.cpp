@@ -0,0 +1,159 @@
+#include <visionsycl/codec.hpp>
+#include <visionsycl/io.hpp>
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb/stb_image.h>
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb/stb_image_write.h>
+
+// TODO: Get rid of stb_image loader and writer
+
+namespace visionsycl {
+
+namespace {
+
+std::string extension_of(const char* filepath) {
+    auto extension = std::filesystem::path(filepath).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return std::tolower(c); });
+    return extension;
+}
+
+struct Registry {
+    std::mutex mutex;
+    std::shared_ptr<const Codec> fallback = std::make_shared<StbCodec>();
+    std::unordered_map<std::string, std::shared_ptr<const Codec>> codecs = {
+        { ".png", fallback },
+        { ".jpg", fallback },
+        { ".jpeg", fallback },
+        { ".bmp", fallback },
+        { ".tga", fallback },
+        { ".gif", fallback },
+        { ".psd", fallback },
+        { ".hdr", fallback },
+        { ".pic", fallback },
+        { ".raw", std::make_shared<RawCodec>() },
+        { ".pnm", std::make_shared<PnmCodec>() },
+        { ".pgm", std::make_shared<PnmCodec>() },
+        { ".ppm", std::make_shared<PnmCodec>() },
+        { ".pam", std::make_shared<PnmCodec>() },
+    };
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+}  // namespace
+
+// HDR files decode to float and 16-bit PNG/PNM to uint16, so their
+// precision survives; everything else decodes to 8 bits
+Image StbCodec::decode(const char* filepath) const {
+    int x, y, comp;
+    void* data;
+    auto type = PixelType::uint8;
+    if (stbi_is_hdr(filepath)) {
+        data = stbi_loadf(filepath, &x, &y, &comp, 0);
+        type = PixelType::float32;
+    }
+    else if (stbi_is_16_bit(filepath)) {
+        data = stbi_load_16(filepath, &x, &y, &comp, 0);
+        type = PixelType::uint16;
+    }
+    else {
+        data = stbi_load(filepath, &x, &y, &comp, 0);
+    }
+    if (data == nullptr)
+        throw std::runtime_error(stbi_failure_reason());
+
+    // stb_image allocates with malloc, which is what pageable images own
+    auto image = Image();
+    image.kind = Storage::pageable;
+    image.allocate(x, y, comp, type);
+    image.data = static_cast<unsigned char*>(data);
+
+    return image;
+}
+
+int StbCodec::encode(const char* filepath, const Image& image) const {
+    auto extension = extension_of(filepath);
+    auto width = image.shape[1];
+    auto height = image.shape[0];
+
+    // stb_image_write only writes 8-bit files, and float to Radiance HDR;
+    // other deeper images go through the PNM or raw codecs
+    if (image.type != PixelType::uint8) {
+        if (image.type != PixelType::float32 || extension != ".hdr")
+            return 0;
+        if (!image.is_contiguous())
+            return this->encode(filepath, image.clone());
+        return stbi_write_hdr(filepath, width, height, image.channels, image.pixels<float>());
+    }
+
+    if (extension == ".png")
+        return stbi_write_png(filepath, width, height, image.channels, image.data, image.step[0]);
+
+    // The remaining writers take tightly packed rows only
+    if (!image.is_contiguous())
+        return this->encode(filepath, image.clone());
+
+    if (extension == ".jpg" || extension == ".jpeg") {
+        constexpr int quality = 95;
+        return stbi_write_jpg(filepath, width, height, image.channels, image.data, quality);
+    }
+    if (extension == ".bmp")
+        return stbi_write_bmp(filepath, width, height, image.channels, image.data);
+    if (extension == ".tga")
+        return stbi_write_tga(filepath, width, height, image.channels, image.data);
+    return stbi_write_png(filepath, width, height, image.channels, image.data, image.step[0]);
+}
+
+Image PnmCodec::decode(const char* filepath) const {
+    auto image = load_pnm(filepath);
+    if (image.data != nullptr)
+        return image;
+    return StbCodec().decode(filepath);
+}
+
+int PnmCodec::encode(const char* filepath, const Image& image) const {
+    return save_pnm(filepath, image);
+}
+
+Image RawCodec::decode(const char* filepath) const {
+    return load_raw(filepath);
+}
+
+int RawCodec::encode(const char* filepath, const Image& image) const {
+    return save_raw(filepath, image);
+}
+
+std::shared_ptr<const Codec> codec_for(const char* filepath) {
+    auto extension = extension_of(filepath);
+    auto& instance = registry();
+    std::lock_guard<std::mutex> lock(instance.mutex);
+
+    auto codec = instance.codecs.find(extension);
+    return codec != instance.codecs.end() ? codec->second : instance.fallback;
+}
+
+bool has_codec(const char* filepath) {
+    auto extension = extension_of(filepath);
+    auto& instance = registry();
+    std::lock_guard<std::mutex> lock(instance.mutex);
+    return instance.codecs.count(extension) != 0;
+}
+
+void register_codec(const std::string& extension, std::shared_ptr<const Codec> codec) {
+    auto key = extension;
+    std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return std::tolower(c); });
+    auto& instance = registry();
+    std::lock_guard<std::mutex> lock(instance.mutex);
+    instance.codecs[key] = std::move(codec);
+}
+
+}  // namespace visionsycl
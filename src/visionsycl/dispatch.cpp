@@ -0,0 +1,37 @@
+#include <visionsycl/dispatch.hpp>
+#include <algorithm>
+
+namespace visionsycl {
+
+size_t Dispatcher::crossover(const std::string& operation) const {
+    auto found = crossovers.find(operation);
+    return found == crossovers.end() ? 0 : found->second;
+}
+
+void Dispatcher::set_crossover(const std::string& operation, size_t pixels) {
+    crossovers[operation] = pixels;
+}
+
+Backend Dispatcher::choose(const std::string& operation, size_t pixels) const {
+    return pixels >= crossover(operation) ? Backend::device : Backend::host;
+}
+
+// Walks down from the largest size, so a noisy win for the device at one
+// small size does not pull the crossover below a size where the host won.
+// Nothing past the largest size was measured, so when the host won there
+// the device still takes every larger frame rather than the host keeping
+// frames of any size.
+size_t Dispatcher::crossover_of(const std::vector<CalibrationSample>& samples) {
+    if (samples.empty())
+        return 0;
+
+    auto sorted = samples;
+    std::sort(sorted.begin(), sorted.end(), [](const CalibrationSample& a, const CalibrationSample& b) { return a.pixels < b.pixels; });
+
+    auto crossover = sorted.back().pixels + 1;
+    for (auto it = sorted.rbegin(); it != sorted.rend() && it->device_milliseconds < it->host_milliseconds; ++it)
+        crossover = it->pixels;
+    return crossover;
+}
+
+}  // namespace visionsycl
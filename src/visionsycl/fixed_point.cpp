@@ -0,0 +1,34 @@
+#include <visionsycl/fixed_point.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace visionsycl {
+
+bool quantize_mask(const float* mask, int length, int shift, int16_t* weights) {
+    auto scale = std::ldexp(1.0, shift);
+    double sum = 0.0;
+    long total = 0;
+    int peak = 0;
+
+    for (int i = 0; i < length; ++i) {
+        auto weight = std::lround(mask[i] * scale);
+        if (weight < std::numeric_limits<int16_t>::min() || weight > std::numeric_limits<int16_t>::max())
+            return false;
+
+        weights[i] = static_cast<int16_t>(weight);
+        sum += mask[i];
+        total += weight;
+        if (std::abs(weights[i]) > std::abs(weights[peak]))
+            peak = i;
+    }
+
+    auto adjusted = weights[peak] + std::lround(sum * scale) - total;
+    if (adjusted < std::numeric_limits<int16_t>::min() || adjusted > std::numeric_limits<int16_t>::max())
+        return false;
+    weights[peak] = static_cast<int16_t>(adjusted);
+
+    return true;
+}
+
+}  // namespace visionsycl
@@ -1,10 +1,9 @@
 #include <visionsycl/image.hpp>
-#define STB_IMAGE_IMPLEMENTATION
-#include <stb/stb_image.h>
-#define STB_IMAGE_WRITE_IMPLEMENTATION
-#include <stb/stb_image_write.h>
-
-// TODO: Get rid of stb_image loader and writer
+#include <visionsycl/codec.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
 
 namespace visionsycl {
 
@@ -12,66 +11,186 @@ Image::Image() {
     this->dimensions = 0;
     this->channels = 0;
     this->length = 0;
-    this->step = nullptr;
-    this->shape = nullptr;
+    this->shape[0] = this->shape[1] = 0;
+    this->step[0] = this->step[1] = 0;
     this->data = nullptr;
+    this->type = PixelType::uint8;
+    this->kind = Storage::view;
 }
 
-Image::Image(int width, int height, int channels) {
-    constexpr auto dims = 2;
-    this->channels = channels;
-    this->dimensions = dims;
+Image::Image(int width, int height, int channels, PixelType type) {
+    this->allocate(width, height, channels, type);
+    this->kind = Storage::pageable;
+    this->data = static_cast<unsigned char*>(std::malloc(this->length));
+    if (this->data == nullptr)
+        throw std::bad_alloc();
+}
 
-    this->step = new int[dims];
-    this->step[0] = 0;
-    this->step[1] = 0;
+Image::Image(int width, int height, int channels, Storage storage, const sycl::queue& q, PixelType type) {
+    this->allocate(width, height, channels, type);
+    this->kind = storage;
+
+    switch (storage) {
+    case Storage::pageable:
+        this->data = static_cast<unsigned char*>(std::malloc(this->length));
+        break;
+    case Storage::pinned:
+        this->data = sycl::malloc_host<unsigned char>(this->length, q);
+        this->context = q.get_context();
+        break;
+    case Storage::shared:
+        this->data = sycl::malloc_shared<unsigned char>(this->length, q);
+        this->context = q.get_context();
+        break;
+    case Storage::mapped:
+        throw std::invalid_argument("mapped images are created with load_raw or load_pnm");
+    case Storage::view:
+        throw std::invalid_argument("views are created with Image::roi");
+    }
+
+    if (this->data == nullptr)
+        throw std::bad_alloc();
+}
 
-    this->shape = new int[dims];
-    this->shape[0] = height;
-    this->shape[1] = width;
+Image::Image(int width, int height, int channels, int stride, unsigned char* data, std::shared_ptr<void> owner, PixelType type) {
+    this->allocate(width, height, channels, type);
+    this->step[0] = stride;
+    this->kind = Storage::mapped;
+    this->data = data;
+    this->owner = std::move(owner);
+}
 
-    this->length = this->channels;
-    for (size_t i = 0; i < this->dimensions; ++i)
-        this->length *= this->shape[i];
+Image::Image(Image&& other) noexcept
+    : channels(other.channels), dimensions(other.dimensions), length(other.length), data(other.data), type(other.type), kind(other.kind), context(std::move(other.context)), owner(std::move(other.owner)) {
+    this->shape[0] = other.shape[0];
+    this->shape[1] = other.shape[1];
+    this->step[0] = other.step[0];
+    this->step[1] = other.step[1];
+
+    other.data = nullptr;
+    other.length = 0;
+    other.kind = Storage::view;
+    other.context.reset();
+}
 
-    this->data = new unsigned char[this->length];
+Image& Image::operator=(Image&& other) noexcept {
+    if (this != &other) {
+        this->release();
+        this->channels = other.channels;
+        this->dimensions = other.dimensions;
+        this->shape[0] = other.shape[0];
+        this->shape[1] = other.shape[1];
+        this->step[0] = other.step[0];
+        this->step[1] = other.step[1];
+        this->length = other.length;
+        this->data = other.data;
+        this->type = other.type;
+        this->kind = other.kind;
+        this->context = std::move(other.context);
+        this->owner = std::move(other.owner);
+
+        other.data = nullptr;
+        other.length = 0;
+        other.kind = Storage::view;
+        other.context.reset();
+    }
+    return *this;
 }
 
 Image::~Image() {
-    delete[] this->shape;
-    delete[] this->step;
-    delete[] this->data;
+    this->release();
 }
 
-Image load_image(const char* filepath) {
+void Image::allocate(int width, int height, int channels, PixelType type) {
     constexpr auto dims = 2;
-    auto image = Image();
+    auto size = static_cast<int>(pixel_size(type));
+    this->channels = channels;
+    this->dimensions = dims;
+    this->type = type;
 
-    int x, y, comp;
-    auto data = stbi_load(filepath, &x, &y, &comp, 0);
+    this->shape[0] = height;
+    this->shape[1] = width;
 
-    image.channels = comp;
-    image.dimensions = dims;
+    this->step[0] = width * channels * size;
+    this->step[1] = channels * size;
 
-    image.step = new int[dims];
-    image.step[0] = 0;
-    image.step[1] = 0;
+    this->length = this->step[1];
+    for (int i = 0; i < this->dimensions; ++i)
+        this->length *= this->shape[i];
+}
 
-    image.shape = new int[dims];
-    image.shape[0] = y;
-    image.shape[1] = x;
+void Image::release() {
+    switch (this->kind) {
+    case Storage::pageable:
+        std::free(this->data);
+        break;
+    case Storage::pinned:
+    case Storage::shared:
+        sycl::free(this->data, *this->context);
+        break;
+    case Storage::mapped:
+        this->owner.reset();
+        break;
+    case Storage::view:
+        break;
+    }
+    this->data = nullptr;
+}
 
-    image.length = image.channels;
-    for (size_t i = 0; i < image.dimensions; ++i)
-        image.length *= image.shape[i];
+Image Image::roi(int x, int y, int width, int height) const {
+    if (x < 0 || y < 0 || width < 0 || height < 0 || x + width > this->shape[1] || y + height > this->shape[0])
+        throw std::out_of_range("region of interest outside of the image");
+
+    auto view = Image();
+    view.channels = this->channels;
+    view.dimensions = this->dimensions;
+    view.shape[0] = height;
+    view.shape[1] = width;
+    view.step[0] = this->step[0];
+    view.step[1] = this->step[1];
+    view.length = static_cast<unsigned long>(width) * height * this->step[1];
+    view.data = this->data + static_cast<size_t>(y) * this->step[0] + static_cast<size_t>(x) * this->step[1];
+    view.type = this->type;
+    view.kind = Storage::view;
+
+    return view;
+}
 
-    image.data = data;
+Image Image::clone() const {
+    auto image = Image(this->shape[1], this->shape[0], this->channels, this->type);
+    for (int row = 0; row < this->shape[0]; ++row)
+        std::memcpy(image.data + static_cast<size_t>(row) * image.step[0], this->data + static_cast<size_t>(row) * this->step[0], image.step[0]);
+    return image;
+}
 
+Image Image::clone(Storage storage, const sycl::queue& q) const {
+    auto image = Image(this->shape[1], this->shape[0], this->channels, storage, q, this->type);
+    for (int row = 0; row < this->shape[0]; ++row)
+        std::memcpy(image.data + static_cast<size_t>(row) * image.step[0], this->data + static_cast<size_t>(row) * this->step[0], image.step[0]);
     return image;
 }
 
+bool Image::is_contiguous() const {
+    return this->step[0] == this->shape[1] * this->step[1];
+}
+
+Storage Image::storage() const {
+    return this->kind;
+}
+
+Image load_image(const char* filepath) {
+    return codec_for(filepath)->decode(filepath);
+}
+
+Image load_image(const char* filepath, Storage storage, const sycl::queue& q) {
+    auto image = load_image(filepath);
+    if (image.storage() == storage)
+        return image;
+    return image.clone(storage, q);
+}
+
 int save_image_as(const char* filepath, Image& image) {
-    return stbi_write_png(filepath, image.shape[1], image.shape[0], image.channels, image.data, 0);
+    return codec_for(filepath)->encode(filepath, image);
 }
 
 }  // namespace visionsycl
@@ -0,0 +1,347 @@
+#include <visionsycl/io.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace visionsycl {
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const char* filepath)
+    : address(nullptr), length(0), file(INVALID_HANDLE_VALUE), mapping(nullptr) {
+    file = CreateFileA(filepath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::system_error(GetLastError(), std::system_category(), filepath);
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        throw std::runtime_error(std::string("cannot map empty file ") + filepath);
+    }
+    length = static_cast<size_t>(size.QuadPart);
+
+    mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (mapping != nullptr)
+        address = static_cast<unsigned char*>(MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0));
+    if (address == nullptr) {
+        auto error = GetLastError();
+        if (mapping != nullptr)
+            CloseHandle(mapping);
+        CloseHandle(file);
+        throw std::system_error(error, std::system_category(), filepath);
+    }
+}
+
+MappedFile::MappedFile(const char* filepath, size_t length)
+    : address(nullptr), length(length), file(INVALID_HANDLE_VALUE), mapping(nullptr) {
+    file = CreateFileA(filepath, GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::system_error(GetLastError(), std::system_category(), filepath);
+
+    auto size = static_cast<unsigned long long>(length);
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32), static_cast<DWORD>(size), nullptr);
+    if (mapping != nullptr)
+        address = static_cast<unsigned char*>(MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, length));
+    if (address == nullptr) {
+        auto error = GetLastError();
+        if (mapping != nullptr)
+            CloseHandle(mapping);
+        CloseHandle(file);
+        throw std::system_error(error, std::system_category(), filepath);
+    }
+}
+
+MappedFile::~MappedFile() {
+    UnmapViewOfFile(address);
+    CloseHandle(mapping);
+    CloseHandle(file);
+}
+
+#else
+
+MappedFile::MappedFile(const char* filepath)
+    : address(nullptr), length(0) {
+    auto fd = ::open(filepath, O_RDONLY);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(), filepath);
+
+    struct stat info;
+    if (::fstat(fd, &info) < 0 || info.st_size == 0) {
+        ::close(fd);
+        throw std::runtime_error(std::string("cannot map empty file ") + filepath);
+    }
+    length = static_cast<size_t>(info.st_size);
+
+    auto ptr = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    auto error = errno;
+    ::close(fd);
+    if (ptr == MAP_FAILED)
+        throw std::system_error(error, std::generic_category(), filepath);
+    address = static_cast<unsigned char*>(ptr);
+}
+
+MappedFile::MappedFile(const char* filepath, size_t length)
+    : address(nullptr), length(length) {
+    auto fd = ::open(filepath, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(), filepath);
+
+    if (::ftruncate(fd, static_cast<off_t>(length)) < 0) {
+        auto error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), filepath);
+    }
+
+    auto ptr = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    auto error = errno;
+    ::close(fd);
+    if (ptr == MAP_FAILED)
+        throw std::system_error(error, std::generic_category(), filepath);
+    address = static_cast<unsigned char*>(ptr);
+}
+
+MappedFile::~MappedFile() {
+    ::munmap(address, length);
+}
+
+#endif
+
+unsigned char* MappedFile::data() const {
+    return address;
+}
+
+size_t MappedFile::size() const {
+    return length;
+}
+
+namespace {
+
+void copy_rows(unsigned char* dst, size_t dst_stride, const Image& image) {
+    auto row_length = static_cast<size_t>(image.shape[1]) * image.step[1];
+    for (int row = 0; row < image.shape[0]; ++row)
+        std::memcpy(dst + row * dst_stride, image.data + static_cast<size_t>(row) * image.step[0], row_length);
+}
+
+RawHeader raw_header(int width, int height, int channels, PixelType type) {
+    RawHeader header;
+    std::memcpy(header.magic, raw_magic, sizeof(raw_magic));
+    header.version = raw_version;
+    header.width = width;
+    header.height = height;
+    header.channels = channels;
+    // Padded so every row, not only the first, starts on the alignment
+    header.stride = (width * channels * pixel_size(type) + raw_alignment - 1) / raw_alignment * raw_alignment;
+    header.dtype = type;
+    header.offset = (sizeof(RawHeader) + raw_alignment - 1) / raw_alignment * raw_alignment;
+    return header;
+}
+
+void write_raw_header(MappedFile& file, const RawHeader& header) {
+    std::memset(file.data(), 0, header.offset);
+    std::memcpy(file.data(), &header, sizeof(header));
+}
+
+// PNM headers are whitespace separated tokens with # comments
+class PnmReader {
+public:
+    PnmReader(const unsigned char* data, size_t length)
+        : data(data), length(length), pos(0) {};
+
+    std::string token() {
+        while (pos < length) {
+            if (data[pos] == '#')
+                while (pos < length && data[pos] != '\n') ++pos;
+            else if (std::isspace(data[pos]))
+                ++pos;
+            else
+                break;
+        }
+        auto start = pos;
+        while (pos < length && !std::isspace(data[pos])) ++pos;
+        return std::string(reinterpret_cast<const char*>(data + start), pos - start);
+    }
+
+    long number() {
+        auto value = token();
+        if (value.empty() || !std::all_of(value.begin(), value.end(), [](unsigned char c) { return std::isdigit(c); }))
+            throw std::runtime_error("malformed PNM header");
+        return std::stol(value);
+    }
+
+    // Exactly one whitespace byte separates the header from the pixels
+    size_t pixels() {
+        return pos + 1;
+    }
+
+private:
+    const unsigned char* data;
+    size_t length;
+    size_t pos;
+};
+
+}  // namespace
+
+Image load_raw(const char* filepath) {
+    auto file = std::make_shared<MappedFile>(filepath);
+    if (file->size() < sizeof(RawHeader))
+        throw std::runtime_error(std::string("truncated raw image ") + filepath);
+
+    RawHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (std::memcmp(header.magic, raw_magic, sizeof(raw_magic)) != 0 || header.version != raw_version)
+        throw std::runtime_error(std::string("not a raw image ") + filepath);
+    if (header.dtype != PixelType::uint8 && header.dtype != PixelType::uint16 && header.dtype != PixelType::float32)
+        throw std::runtime_error(std::string("unsupported raw pixel type in ") + filepath);
+
+    // Every field comes from the file, so bound each one before the
+    // arithmetic and compare sizes by subtraction, which cannot wrap
+    constexpr uint32_t max_side = std::numeric_limits<int>::max();
+    if (header.channels < 1 || header.channels > 4 || header.width > max_side || header.height > max_side || header.stride > max_side)
+        throw std::runtime_error(std::string("malformed raw image ") + filepath);
+    if (header.offset < sizeof(RawHeader) || header.offset > file->size())
+        throw std::runtime_error(std::string("malformed raw image ") + filepath);
+
+    auto row_length = static_cast<uint64_t>(header.width) * header.channels * pixel_size(header.dtype);
+    if (header.stride < row_length || header.offset % pixel_size(header.dtype) != 0 || header.stride % pixel_size(header.dtype) != 0)
+        throw std::runtime_error(std::string("malformed raw image ") + filepath);
+    if (header.height > 0 && static_cast<uint64_t>(header.height - 1) * header.stride + row_length > file->size() - header.offset)
+        throw std::runtime_error(std::string("truncated raw image ") + filepath);
+
+    auto data = file->data() + header.offset;
+    return Image(header.width, header.height, header.channels, header.stride, data, std::move(file), header.dtype);
+}
+
+Image load_pnm(const char* filepath) {
+    auto file = std::make_shared<MappedFile>(filepath);
+    auto reader = PnmReader(file->data(), file->size());
+
+    auto magic = reader.token();
+    long width = 0, height = 0, channels = 0, maxval = 0;
+    if (magic == "P5" || magic == "P6") {
+        width = reader.number();
+        height = reader.number();
+        maxval = reader.number();
+        channels = magic == "P5" ? 1 : 3;
+    }
+    else if (magic == "P7") {
+        for (auto key = reader.token(); key != "ENDHDR"; key = reader.token()) {
+            if (key.empty())
+                throw std::runtime_error(std::string("malformed PAM header in ") + filepath);
+            else if (key == "WIDTH")
+                width = reader.number();
+            else if (key == "HEIGHT")
+                height = reader.number();
+            else if (key == "DEPTH")
+                channels = reader.number();
+            else if (key == "MAXVAL")
+                maxval = reader.number();
+            else if (key == "TUPLTYPE")
+                reader.token();
+        }
+    }
+    else {
+        return Image();
+    }
+
+    if (maxval < 1 || maxval > 65535 || channels < 1 || channels > 4)
+        return Image();
+
+    auto sample = maxval > 255 ? 2 : 1;
+    auto offset = reader.pixels();
+    auto stride = static_cast<size_t>(width) * channels * sample;
+    if (offset + stride * height > file->size())
+        throw std::runtime_error(std::string("truncated PNM image ") + filepath);
+
+    auto data = file->data() + offset;
+    if (sample == 1)
+        return Image(width, height, channels, stride, data, std::move(file));
+
+    // Big-endian samples, swapped while copying out of the mapping
+    auto image = Image(width, height, channels, PixelType::uint16);
+    auto pixels = image.pixels<uint16_t>();
+    for (size_t i = 0; i < image.length / 2; ++i)
+        pixels[i] = static_cast<uint16_t>(data[2 * i] << 8 | data[2 * i + 1]);
+    return image;
+}
+
+int save_raw(const char* filepath, const Image& image) {
+    try {
+        auto header = raw_header(image.shape[1], image.shape[0], image.channels, image.type);
+        auto file = MappedFile(filepath, header.offset + static_cast<size_t>(header.stride) * header.height);
+        write_raw_header(file, header);
+        copy_rows(file.data() + header.offset, header.stride, image);
+    } catch (std::exception const&) {
+        return 0;
+    }
+    return 1;
+}
+
+Image create_raw(const char* filepath, int width, int height, int channels, PixelType type) {
+    auto header = raw_header(width, height, channels, type);
+    auto file = std::make_shared<MappedFile>(filepath, header.offset + static_cast<size_t>(header.stride) * header.height);
+    write_raw_header(*file, header);
+
+    auto data = file->data() + header.offset;
+    return Image(width, height, channels, header.stride, data, std::move(file), type);
+}
+
+int save_pnm(const char* filepath, const Image& image) {
+    if (image.type == PixelType::float32)
+        return 0;
+
+    std::string header;
+    auto width = std::to_string(image.shape[1]);
+    auto height = std::to_string(image.shape[0]);
+    auto maxval = std::string(image.type == PixelType::uint16 ? "65535" : "255");
+    switch (image.channels) {
+    case 1:
+        header = "P5\n" + width + " " + height + "\n" + maxval + "\n";
+        break;
+    case 3:
+        header = "P6\n" + width + " " + height + "\n" + maxval + "\n";
+        break;
+    case 2:
+    case 4:
+        header = "P7\nWIDTH " + width + "\nHEIGHT " + height + "\nDEPTH " + std::to_string(image.channels) +
+                 "\nMAXVAL " + maxval + "\nTUPLTYPE " + (image.channels == 2 ? "GRAYSCALE_ALPHA" : "RGB_ALPHA") + "\nENDHDR\n";
+        break;
+    default:
+        return 0;
+    }
+
+    try {
+        auto stride = static_cast<size_t>(image.shape[1]) * image.step[1];
+        auto file = MappedFile(filepath, header.size() + stride * image.shape[0]);
+        std::memcpy(file.data(), header.data(), header.size());
+        copy_rows(file.data() + header.size(), stride, image);
+
+        // PNM wants 16-bit samples big-endian
+        if (image.type == PixelType::uint16) {
+            auto pixels = file.data() + header.size();
+            for (size_t i = 0; i < stride * image.shape[0]; i += 2)
+                std::swap(pixels[i], pixels[i + 1]);
+        }
+    } catch (std::exception const&) {
+        return 0;
+    }
+    return 1;
+}
+
+}  // namespace visionsycl
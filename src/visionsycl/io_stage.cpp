@@ -0,0 +1,49 @@
+#include <visionsycl/io_stage.hpp>
+#include <visionsycl/codec.hpp>
+#include <algorithm>
+#include <filesystem>
+
+namespace visionsycl {
+
+IoStage::IoStage(size_t threads, size_t max_pending)
+    : pool(threads), max_pending(max_pending) {
+    if (this->max_pending == 0)
+        this->max_pending = 2 * pool.size();
+}
+
+void IoStage::encode(std::string filepath, Image image) {
+    auto task = [filepath = std::move(filepath), image = std::move(image)] {
+        return codec_for(filepath.c_str())->encode(filepath.c_str(), image);
+    };
+    encodes.push_back(pool.submit(std::move(task)));
+}
+
+size_t IoStage::flush() {
+    size_t failures = 0;
+    for (auto& encode : encodes) {
+        try {
+            failures += encode.get() == 0;
+        } catch (...) {
+            ++failures;
+        }
+    }
+    encodes.clear();
+    return failures;
+}
+
+size_t IoStage::threads() const {
+    return pool.size();
+}
+
+std::vector<std::string> IoStage::list_directory(const char* directory) {
+    std::vector<std::string> filepaths;
+    for (auto& entry : std::filesystem::directory_iterator(directory)) {
+        auto filepath = entry.path().generic_string();
+        if (entry.is_regular_file() && has_codec(filepath.c_str()))
+            filepaths.push_back(std::move(filepath));
+    }
+    std::sort(filepaths.begin(), filepaths.end());
+    return filepaths;
+}
+
+}  // namespace visionsycl
@@ -0,0 +1,81 @@
+#include <visionsycl/memory.hpp>
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace visionsycl {
+
+MemoryPool::MemoryPool(sycl::queue& q, sycl::usm::alloc kind)
+    : q(q), kind(kind), counters{ 0, 0, 0, 0, 0 } {}
+
+MemoryPool::~MemoryPool() {
+    for (auto& [ptr, size] : live)
+        sycl::free(ptr, q);
+    release();
+}
+
+size_t MemoryPool::size_class(size_t bytes) {
+    constexpr size_t min_class = 256;
+    if (bytes <= min_class)
+        return min_class;
+
+    auto step = std::max(std::bit_floor(bytes) / 4, min_class);
+    return (bytes + step - 1) / step * step;
+}
+
+void* MemoryPool::allocate(size_t bytes) {
+    auto size = size_class(bytes);
+    std::lock_guard<std::mutex> lock(mutex);
+
+    void* ptr = nullptr;
+    auto& blocks = cached[size];
+    if (!blocks.empty()) {
+        ptr = blocks.back();
+        blocks.pop_back();
+        ++counters.hits;
+    }
+    else {
+        ptr = sycl::malloc(size, q, kind);
+        if (ptr == nullptr)
+            throw std::bad_alloc();
+        counters.bytes_reserved += size;
+        ++counters.misses;
+    }
+
+    live[ptr] = size;
+    counters.bytes_in_use += size;
+    counters.high_water_mark = std::max(counters.high_water_mark, counters.bytes_in_use);
+
+    return ptr;
+}
+
+void MemoryPool::deallocate(void* ptr) {
+    if (ptr == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = live.find(ptr);
+    if (it == live.end())
+        throw std::invalid_argument("pointer was not allocated by this pool");
+
+    cached[it->second].push_back(ptr);
+    counters.bytes_in_use -= it->second;
+    live.erase(it);
+}
+
+void MemoryPool::release() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& [size, blocks] : cached) {
+        for (auto ptr : blocks)
+            sycl::free(ptr, q);
+        counters.bytes_reserved -= size * blocks.size();
+        blocks.clear();
+    }
+}
+
+PoolStats MemoryPool::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
+
+}  // namespace visionsycl
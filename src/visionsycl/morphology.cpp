@@ -0,0 +1,14 @@
+#include <visionsycl/morphology.hpp>
+
+namespace visionsycl {
+
+bool is_rectangle_mask(const unsigned char* mask, int mask_width, int mask_height) {
+    if (mask_width % 2 == 0 || mask_height % 2 == 0)
+        return false;
+    for (int i = 0; i < mask_width * mask_height; ++i)
+        if (mask[i] == 0)
+            return false;
+    return true;
+}
+
+}  // namespace visionsycl
@@ -0,0 +1,170 @@
+#include <visionsycl/multi_device.hpp>
+#include <cmath>
+#include <string>
+
+namespace visionsycl {
+
+std::vector<sycl::device> row_split_devices(int (*selector)(const sycl::device&)) {
+    std::vector<std::string> names;
+    std::vector<int> scores;
+    std::vector<sycl::device> best;
+    for (auto& device : sycl::device::get_devices()) {
+        auto score = selector(device);
+        if (score < 0 || !device.has(sycl::aspect::usm_device_allocations))
+            continue;
+
+        auto name = device.get_info<sycl::info::device::name>();
+        auto found = std::find(names.begin(), names.end(), name);
+        if (found == names.end()) {
+            names.push_back(name);
+            scores.push_back(score);
+            best.push_back(device);
+        }
+        else if (auto i = found - names.begin(); scores[i] < score) {
+            scores[i] = score;
+            best[i] = device;
+        }
+    }
+
+    std::vector<sycl::device> devices;
+    for (auto& device : best) {
+        auto parts = numa_sub_devices(device);
+        devices.insert(devices.end(), parts.begin(), parts.end());
+    }
+    return devices;
+}
+
+std::vector<sycl::device> numa_sub_devices(const sycl::device& device) {
+    if (!device.is_cpu())
+        return { device };
+
+    auto properties = device.get_info<sycl::info::device::partition_properties>();
+    auto domains = device.get_info<sycl::info::device::partition_affinity_domains>();
+    auto by_affinity = std::find(properties.begin(), properties.end(), sycl::info::partition_property::partition_by_affinity_domain) != properties.end();
+    auto by_numa = std::find(domains.begin(), domains.end(), sycl::info::partition_affinity_domain::numa) != domains.end();
+    if (!by_affinity || !by_numa)
+        return { device };
+
+    // Single-domain machines may refuse the partition, which is no error here
+    try {
+        auto parts = device.create_sub_devices<sycl::info::partition_property::partition_by_affinity_domain>(sycl::info::partition_affinity_domain::numa);
+        if (parts.size() > 1)
+            return parts;
+    } catch (sycl::exception const&) {
+    }
+    return { device };
+}
+
+RowSplitExecutor::RowSplitExecutor(const std::vector<sycl::device>& devices) {
+    if (devices.empty())
+        throw std::invalid_argument("row-split needs at least one device");
+
+    for (auto& device : devices) {
+        auto can_profile = device.has(sycl::aspect::queue_profiling);
+        if (can_profile)
+            queues.emplace_back(device, sycl::property_list{ sycl::property::queue::enable_profiling() });
+        else
+            queues.emplace_back(device);
+        pools.push_back(std::make_unique<MemoryPool>(queues.back()));
+        profiled.push_back(can_profile);
+    }
+
+    weights.assign(queues.size(), 1.0);
+    measured.assign(queues.size(), false);
+    bands.assign(queues.size(), { 0, 0, 0.0 });
+    uploads.resize(queues.size());
+    downloads.resize(queues.size());
+    inputs.assign(queues.size(), nullptr);
+    outputs.assign(queues.size(), nullptr);
+}
+
+size_t RowSplitExecutor::size() const {
+    return queues.size();
+}
+
+const std::vector<sycl::queue>& RowSplitExecutor::devices() const {
+    return queues;
+}
+
+const std::vector<Band>& RowSplitExecutor::last_bands() const {
+    return bands;
+}
+
+// Every device holds room for the whole image, so rebalancing never has to
+// reallocate
+void RowSplitExecutor::reserve(size_t input_length, size_t output_length) {
+    if (input_length > input_capacity) {
+        for (size_t i = 0; i < queues.size(); ++i) {
+            if (inputs[i])
+                pools[i]->deallocate(inputs[i]);
+            inputs[i] = pools[i]->allocate<uint8_t>(input_length);
+        }
+        input_capacity = input_length;
+    }
+    if (output_length > output_capacity) {
+        for (size_t i = 0; i < queues.size(); ++i) {
+            if (outputs[i])
+                pools[i]->deallocate(outputs[i]);
+            outputs[i] = pools[i]->allocate<uint8_t>(output_length);
+        }
+        output_capacity = output_length;
+    }
+}
+
+// Each device keeps at least one row while there are enough of them, so a
+// slow device is still measured and can win rows back
+void RowSplitExecutor::split(int height) {
+    auto count = static_cast<int>(queues.size());
+    auto reserved = height >= count ? 1 : 0;
+    auto shared = height - reserved * count;
+
+    double total = 0.0;
+    for (auto weight : weights) total += weight;
+
+    double cumulative = 0.0;
+    int first = 0, previous = 0;
+    for (int i = 0; i < count; ++i) {
+        cumulative += weights[i];
+        auto boundary = i == count - 1 ? shared : static_cast<int>(std::lround(shared * cumulative / total));
+        auto rows = boundary - previous + reserved;
+        bands[i] = { first, std::min(rows, height - first), 0.0 };
+        first += bands[i].rows;
+        previous = boundary;
+    }
+}
+
+// Device time of a band runs from the start of its upload to the end of its
+// download; throughput is smoothed so one noisy run does not swing the split
+void RowSplitExecutor::balance() {
+    constexpr double smoothing = 0.25;
+    for (size_t i = 0; i < queues.size(); ++i) {
+        if (bands[i].rows == 0 || !profiled[i])
+            continue;
+
+        auto start = uploads[i].get_profiling_info<sycl::info::event_profiling::command_start>();
+        auto end = downloads[i].get_profiling_info<sycl::info::event_profiling::command_end>();
+        bands[i].milliseconds = (end - start) * 1e-6;
+        if (bands[i].milliseconds <= 0.0)
+            continue;
+
+        auto throughput = bands[i].rows / bands[i].milliseconds;
+        weights[i] = measured[i] ? (1.0 - smoothing) * weights[i] + smoothing * throughput : throughput;
+        measured[i] = true;
+    }
+
+    // Devices that cannot be timed keep the mean weight of the others
+    double sum = 0.0;
+    size_t timed = 0;
+    for (size_t i = 0; i < queues.size(); ++i)
+        if (measured[i]) {
+            sum += weights[i];
+            ++timed;
+        }
+    if (timed == 0)
+        return;
+    for (size_t i = 0; i < queues.size(); ++i)
+        if (!measured[i])
+            weights[i] = sum / timed;
+}
+
+}  // namespace visionsycl
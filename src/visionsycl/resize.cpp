@@ -0,0 +1,29 @@
+#include <visionsycl/resize.hpp>
+
+namespace visionsycl {
+
+std::vector<PyramidLevel> pyramid_layout(int width, int height, int channels, int levels) {
+    constexpr size_t alignment = 64;
+    std::vector<PyramidLevel> layout;
+    size_t offset = 0;
+
+    for (int i = 0; i < levels; ++i) {
+        layout.push_back({ width, height, offset });
+        offset += (static_cast<size_t>(width) * height * channels + alignment - 1) / alignment * alignment;
+        if (width == 1 && height == 1)
+            break;
+        width = (width + 1) / 2;
+        height = (height + 1) / 2;
+    }
+
+    return layout;
+}
+
+size_t pyramid_length(const std::vector<PyramidLevel>& layout, int channels) {
+    if (layout.empty())
+        return 0;
+    auto& last = layout.back();
+    return last.offset + static_cast<size_t>(last.width) * last.height * channels;
+}
+
+}  // namespace visionsycl
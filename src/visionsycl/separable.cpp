@@ -0,0 +1,49 @@
+#include <visionsycl/separable.hpp>
+#include <cmath>
+
+namespace visionsycl {
+
+bool separate_mask(const float* mask, int mask_width, int mask_height, float* row, float* column) {
+    auto length = mask_width * mask_height;
+
+    // Pivot on the largest weight to keep the factorisation well conditioned
+    int pivot = 0;
+    for (int i = 1; i < length; ++i)
+        if (std::fabs(mask[i]) > std::fabs(mask[pivot]))
+            pivot = i;
+
+    auto peak = mask[pivot];
+    if (peak == 0.0f)
+        return false;
+
+    auto px = pivot / mask_height;
+    auto py = pivot % mask_height;
+    for (int x = 0; x < mask_width; ++x)
+        row[x] = mask[x * mask_height + py];
+    for (int y = 0; y < mask_height; ++y)
+        column[y] = mask[px * mask_height + y] / peak;
+
+    auto tolerance = std::fabs(peak) * 1e-5f;
+    for (int x = 0; x < mask_width; ++x)
+        for (int y = 0; y < mask_height; ++y)
+            if (std::fabs(row[x] * column[y] - mask[x * mask_height + y]) > tolerance)
+                return false;
+
+    return true;
+}
+
+void gaussian_vector(int length, float sigma, float* vector) {
+    auto mid = length / 2;
+    float sum = 0.0f;
+
+    for (int i = 0; i < length; ++i) {
+        auto d = static_cast<float>(i - mid);
+        vector[i] = std::exp(-(d * d) / (2.0f * sigma * sigma));
+        sum += vector[i];
+    }
+
+    for (int i = 0; i < length; ++i)
+        vector[i] /= sum;
+}
+
+}  // namespace visionsycl
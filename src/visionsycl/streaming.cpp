@@ -0,0 +1,67 @@
+#include <visionsycl/streaming.hpp>
+#include <cstring>
+
+namespace visionsycl {
+
+StreamingExecutor::StreamingExecutor(sycl::queue& q, size_t budget)
+    : q(q), budget(budget) {}
+
+StreamingExecutor::~StreamingExecutor() {
+    for (auto& download : downloads)
+        download.wait();
+    for (int slot = 0; slot < 2; ++slot) {
+        sycl::free(inputs[slot], q);
+        sycl::free(outputs[slot], q);
+        sycl::free(staged_inputs[slot], q);
+        sycl::free(staged_outputs[slot], q);
+    }
+}
+
+// Both slots hold rows + 2 * halo rows of input and of output, since the
+// launch computes every row it uploads
+int StreamingExecutor::band_rows(size_t in_row, size_t out_row, int halo) const {
+    auto row_bytes = in_row + out_row;
+    auto slot_budget = budget / 2;
+    auto halo_bytes = 2 * static_cast<size_t>(halo) * row_bytes;
+    if (row_bytes == 0 || slot_budget <= halo_bytes)
+        return 0;
+    return static_cast<int>(std::min<size_t>((slot_budget - halo_bytes) / row_bytes, INT32_MAX));
+}
+
+// Buffers only grow, so later images of the same size reuse them
+void StreamingExecutor::reserve(size_t input_length, size_t output_length) {
+    if (input_length > input_capacity) {
+        for (int slot = 0; slot < 2; ++slot) {
+            sycl::free(inputs[slot], q);
+            sycl::free(staged_inputs[slot], q);
+            inputs[slot] = sycl::malloc_device<uint8_t>(input_length, q);
+            staged_inputs[slot] = sycl::malloc_host<uint8_t>(input_length, q);
+        }
+        input_capacity = input_length;
+    }
+    if (output_length > output_capacity) {
+        for (int slot = 0; slot < 2; ++slot) {
+            sycl::free(outputs[slot], q);
+            sycl::free(staged_outputs[slot], q);
+            outputs[slot] = sycl::malloc_device<uint8_t>(output_length, q);
+            staged_outputs[slot] = sycl::malloc_host<uint8_t>(output_length, q);
+        }
+        output_capacity = output_length;
+    }
+}
+
+// Rows are packed into pinned memory so the upload can run asynchronously
+// whatever the input storage, and strided views are read correctly
+void StreamingExecutor::stage(const Image& input, size_t slot, int top, int bottom, size_t in_row) {
+    for (int row = top; row < bottom; ++row)
+        std::memcpy(staged_inputs[slot] + (row - top) * in_row, input.data + static_cast<size_t>(row) * input.step[0], in_row);
+}
+
+void StreamingExecutor::retire(Image& output, size_t slot, size_t out_row) {
+    downloads[slot].wait_and_throw();
+    auto& band = pending[slot];
+    for (int row = 0; row < band.rows; ++row)
+        std::memcpy(output.data + static_cast<size_t>(band.first_row + row) * output.step[0], staged_outputs[slot] + row * out_row, out_row);
+}
+
+}  // namespace visionsycl
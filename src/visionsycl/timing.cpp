@@ -0,0 +1,40 @@
+#include <visionsycl/timing.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace visionsycl {
+
+LatencyStats summarize(std::vector<double> samples) {
+    if (samples.empty())
+        return { 0, 0, 0, 0, 0, 0, 0 };
+
+    std::sort(samples.begin(), samples.end());
+    auto count = samples.size();
+    auto rank = [&samples, count](double p) {
+        auto k = static_cast<size_t>(std::ceil(p * count));
+        return samples[std::clamp<size_t>(k, 1, count) - 1];
+    };
+
+    return {
+        count,
+        samples.front(),
+        std::accumulate(samples.begin(), samples.end(), 0.0) / count,
+        rank(0.50),
+        rank(0.95),
+        rank(0.99),
+        samples.back()
+    };
+}
+
+double device_milliseconds(const std::vector<sycl::event>& events) {
+    uint64_t nanoseconds = 0;
+    for (auto& event : events) {
+        auto start = event.get_profiling_info<sycl::info::event_profiling::command_start>();
+        auto end = event.get_profiling_info<sycl::info::event_profiling::command_end>();
+        nanoseconds += end - start;
+    }
+    return nanoseconds * 1e-6;
+}
+
+}  // namespace visionsycl
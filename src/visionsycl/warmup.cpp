@@ -0,0 +1,21 @@
+#include <visionsycl/warmup.hpp>
+#include <chrono>
+#include <vector>
+
+namespace visionsycl {
+
+KernelBuild build_kernels(const sycl::queue& q) {
+    auto start = std::chrono::steady_clock::now();
+    auto context = q.get_context();
+    auto devices = std::vector<sycl::device>{ q.get_device() };
+
+    auto bundle = sycl::has_kernel_bundle<sycl::bundle_state::executable>(context, devices)
+                      ? sycl::get_kernel_bundle<sycl::bundle_state::executable>(context, devices)
+                      : sycl::build(sycl::get_kernel_bundle<sycl::bundle_state::input>(context, devices));
+
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    auto kernels = bundle.get_kernel_ids().size();
+    return { std::move(bundle), kernels, elapsed };
+}
+
+}  // namespace visionsycl